@@ -7,7 +7,7 @@ double hyp (double a,double b)
 	double c;
 	c = a * a + b * b;
 
-	return std::pow(c,0.5);
+	return std::sqrt(c);
 }
 
 int main(int argc, char **argv)
@@ -29,7 +29,13 @@ public:
         if (speed < target_speed)
         {
             speed += acceleration * time;
-            accumulated_pollution += pollution_rate * pow(10, acceleration);
+            if (acceleration != pollution_acceleration)
+            {
+                // pow is only re-evaluated when the acceleration changes
+                pollution_acceleration = acceleration;
+                pollution_factor = pow(10, acceleration);
+            }
+            accumulated_pollution += pollution_rate * pollution_factor;
             time_running += time;
         }
         printf("%s has been running %f sec, current speed: %f pollution: %f\n",
@@ -46,6 +52,8 @@ protected:
         , accumulated_pollution(0.0)
         , time_running(0.0)
         , inertial_speed(0.0)
+        , pollution_acceleration(NAN)
+        , pollution_factor(0.0)
     {
     }
 
@@ -60,6 +68,10 @@ protected:
     double accumulated_pollution;
     double time_running;
     double inertial_speed;
+
+private:
+    double pollution_acceleration;  // acceleration pollution_factor was computed for
+    double pollution_factor;        // pow(10, pollution_acceleration)
 };
 
 class Honda : public Car
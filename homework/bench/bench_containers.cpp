@@ -0,0 +1,503 @@
+// Throughput and latency of mixed find/insert/erase workloads against the
+// homework containers, from 1 to N threads.
+//
+// Threads are pinned to cores (Linux) and either share one container behind
+// a mutex, or each work on a private container ("--sharing private"), which
+// separates lock contention from the cost of the container itself. Every
+// operation is timed; results are reported per (container, thread count) as
+// ops/sec and p50/p99/p999 latency in CSV or JSON.
+//
+// usage: bench_containers [--containers list,treap,splay,compact,radix,flat,std::set]
+//                         [--threads N] [--ops per-thread] [--keys N]
+//                         [--mix find:insert:erase] [--dist uniform|zipf:S]
+//                         [--sharing shared|private] [--format csv|json]
+//
+// LinkedList's member functions are exercises, so the "list" container links
+// LinkedList::Node directly; likewise "treap" runs the bst:: join/split
+// functions on BinarySearchTree<int>::Node.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "hw08.h"
+#include "hw09.h"
+#include "hw09_compact.h"
+#include "hw09_flat_hash.h"
+#include "hw09_radix.h"
+#include "hw09_splay.h"
+#include "zipf.h"
+
+namespace
+{
+    // Unsorted doubly linked list of LinkedList::Node with a sentinel
+    class ListAdapter
+    {
+    public:
+        using Node = cppclass::LinkedList::Node;
+
+        ListAdapter()
+        {
+            _sentinel.next = _sentinel.prev = &_sentinel;
+        }
+
+        ~ListAdapter()
+        {
+            for (Node *node = _sentinel.next; node != &_sentinel;)
+            {
+                Node *next = node->next;
+                delete node;
+                node = next;
+            }
+        }
+
+        bool find(int key) const
+        {
+            return search(key) != nullptr;
+        }
+
+        bool insert(int key)
+        {
+            if (search(key) != nullptr)
+            {
+                return false;
+            }
+            Node *node = new Node();
+            node->data = key;
+            node->prev = _sentinel.prev;
+            node->next = &_sentinel;
+            _sentinel.prev->next = node;
+            _sentinel.prev = node;
+            return true;
+        }
+
+        bool erase(int key)
+        {
+            Node *node = search(key);
+            if (node == nullptr)
+            {
+                return false;
+            }
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+            delete node;
+            return true;
+        }
+
+    private:
+        Node *search(int key) const
+        {
+            for (Node *node = _sentinel.next; node != &_sentinel; node = node->next)
+            {
+                if (node->data == key)
+                {
+                    return node;
+                }
+            }
+            return nullptr;
+        }
+
+        Node _sentinel;
+    };
+
+    class TreapAdapter
+    {
+    public:
+        using Node = cppclass::BinarySearchTree<int>::Node;
+
+        ~TreapAdapter()
+        {
+            cppclass::bst::destroy(_root);
+        }
+
+        bool find(int key) const
+        {
+            return cppclass::bst::find(_root, key) != nullptr;
+        }
+
+        bool insert(int key)
+        {
+            if (find(key))
+            {
+                return false;
+            }
+            return cppclass::bst::insert(_root, new Node(key));
+        }
+
+        bool erase(int key)
+        {
+            return cppclass::bst::erase(_root, key);
+        }
+
+    private:
+        Node *_root = nullptr;
+    };
+
+    // find/insert/erase on top of the contains/insert/remove trees
+    template <typename Tree>
+    class TreeAdapter
+    {
+    public:
+        bool find(int key) const
+        {
+            return _tree.contains(key);
+        }
+
+        bool insert(int key)
+        {
+            return _tree.insert(key);
+        }
+
+        bool erase(int key)
+        {
+            return _tree.remove(key);
+        }
+
+    private:
+        Tree _tree;
+    };
+
+    class StdSetAdapter
+    {
+    public:
+        bool find(int key) const
+        {
+            return _set.count(key) != 0;
+        }
+
+        bool insert(int key)
+        {
+            return _set.insert(key).second;
+        }
+
+        bool erase(int key)
+        {
+            return _set.erase(key) != 0;
+        }
+
+    private:
+        std::set<int> _set;
+    };
+
+    struct Options
+    {
+        std::vector<std::string> containers = {"list", "treap", "splay", "compact", "radix", "flat", "std::set"};
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+        size_t ops = 200000;
+        size_t keys = 10000;
+        unsigned mix[3] = {80, 10, 10}; // find, insert, erase weights
+        double zipf = 0.0;              // 0 is uniform
+        bool shared = true;
+        bool json = false;
+    };
+
+    struct Result
+    {
+        std::string container;
+        unsigned threads;
+        size_t ops;
+        double seconds;
+        size_t hits; // operations that found, inserted or erased their key
+        uint64_t p50;
+        uint64_t p99;
+        uint64_t p999;
+    };
+
+    void pin_to_core(unsigned index)
+    {
+#ifdef __linux__
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index % cores, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof set, &set);
+#else
+        (void)index;
+#endif
+    }
+
+    // Pre-generates one thread's operations so the timed loop only runs them
+    struct Operation
+    {
+        uint8_t kind; // 0 find, 1 insert, 2 erase
+        int key;
+    };
+
+    std::vector<Operation> make_operations(const Options &options, const std::vector<int> &key_of_rank,
+                                           unsigned seed)
+    {
+        std::mt19937_64 rng(seed);
+        cppclass::ZipfDistribution zipf(options.keys, options.zipf);
+        std::uniform_int_distribution<size_t> uniform(0, options.keys - 1);
+        std::discrete_distribution<int> kind({double(options.mix[0]), double(options.mix[1]), double(options.mix[2])});
+        std::vector<Operation> ops(options.ops);
+        for (Operation &op : ops)
+        {
+            size_t rank = options.zipf > 0.0 ? zipf(rng) : uniform(rng);
+            op.kind = static_cast<uint8_t>(kind(rng));
+            op.key = key_of_rank[rank];
+        }
+        return ops;
+    }
+
+    template <typename Adapter>
+    Result run(const std::string &name, const Options &options, unsigned threads)
+    {
+        // Keys are ranked by popularity in a shuffled order so hot keys are
+        // spread over the key space
+        std::vector<int> key_of_rank(options.keys);
+        std::iota(key_of_rank.begin(), key_of_rank.end(), 0);
+        std::shuffle(key_of_rank.begin(), key_of_rank.end(), std::mt19937(42));
+
+        size_t containers = options.shared ? 1 : threads;
+        std::vector<std::unique_ptr<Adapter>> adapters;
+        for (size_t c = 0; c < containers; ++c)
+        {
+            adapters.push_back(std::make_unique<Adapter>());
+            // Start half full so inserts and erases both succeed often
+            for (size_t k = 0; k < options.keys; k += 2)
+            {
+                adapters.back()->insert(static_cast<int>(k));
+            }
+        }
+
+        std::vector<std::vector<Operation>> work;
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            work.push_back(make_operations(options, key_of_rank, 1000 + t));
+        }
+
+        std::mutex lock;
+        std::atomic<unsigned> ready{0};
+        std::atomic<bool> go{false};
+        std::atomic<size_t> total_hits{0};
+        std::vector<std::vector<uint32_t>> latencies(threads);
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            pool.emplace_back([&, t] {
+                pin_to_core(t);
+                Adapter &adapter = *adapters[options.shared ? 0 : t];
+                std::vector<uint32_t> &latency = latencies[t];
+                latency.reserve(work[t].size());
+                size_t hits = 0;
+                ready.fetch_add(1);
+                while (!go.load(std::memory_order_acquire))
+                {
+                }
+                for (const Operation &op : work[t])
+                {
+                    auto begin = std::chrono::steady_clock::now();
+                    {
+                        std::unique_lock<std::mutex> guard(lock, std::defer_lock);
+                        if (options.shared)
+                        {
+                            guard.lock();
+                        }
+                        switch (op.kind)
+                        {
+                        case 0:
+                            hits += adapter.find(op.key);
+                            break;
+                        case 1:
+                            hits += adapter.insert(op.key);
+                            break;
+                        default:
+                            hits += adapter.erase(op.key);
+                            break;
+                        }
+                    }
+                    auto elapsed = std::chrono::steady_clock::now() - begin;
+                    latency.push_back(static_cast<uint32_t>(
+                        std::min<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                          UINT32_MAX)));
+                }
+                // Publishing the hit count keeps finds from being optimized away
+                total_hits.fetch_add(hits);
+            });
+        }
+        while (ready.load() < threads)
+        {
+        }
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (std::thread &thread : pool)
+        {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<uint32_t> all;
+        for (const auto &latency : latencies)
+        {
+            all.insert(all.end(), latency.begin(), latency.end());
+        }
+        auto percentile = [&](double p) -> uint64_t {
+            if (all.empty())
+            {
+                return 0;
+            }
+            size_t index = std::min(all.size() - 1, static_cast<size_t>(p * all.size()));
+            std::nth_element(all.begin(), all.begin() + index, all.end());
+            return all[index];
+        };
+        return {name, threads, all.size(), seconds, total_hits.load(), percentile(0.50), percentile(0.99),
+                percentile(0.999)};
+    }
+
+    bool parse(int argc, char **argv, Options &options)
+    {
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            std::string flag = argv[i];
+            std::string value = argv[i + 1];
+            if (flag == "--containers")
+            {
+                options.containers.clear();
+                std::stringstream list(value);
+                for (std::string name; std::getline(list, name, ',');)
+                {
+                    options.containers.push_back(name);
+                }
+            }
+            else if (flag == "--threads")
+            {
+                options.threads = std::max(1, std::atoi(value.c_str()));
+            }
+            else if (flag == "--ops")
+            {
+                options.ops = std::strtoull(value.c_str(), nullptr, 10);
+            }
+            else if (flag == "--keys")
+            {
+                options.keys = std::max<size_t>(1, std::strtoull(value.c_str(), nullptr, 10));
+            }
+            else if (flag == "--mix")
+            {
+                if (std::sscanf(value.c_str(), "%u:%u:%u", &options.mix[0], &options.mix[1], &options.mix[2]) != 3
+                    || options.mix[0] + options.mix[1] + options.mix[2] == 0)
+                {
+                    return false;
+                }
+            }
+            else if (flag == "--dist")
+            {
+                options.zipf = value.rfind("zipf:", 0) == 0 ? std::atof(value.c_str() + 5) : 0.0;
+            }
+            else if (flag == "--sharing")
+            {
+                options.shared = value != "private";
+            }
+            else if (flag == "--format")
+            {
+                options.json = value == "json";
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return argc % 2 == 1;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parse(argc, argv, options))
+    {
+        std::fprintf(stderr, "usage: see the comment at the top of bench_containers.cpp\n");
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Result> results;
+    for (const std::string &name : options.containers)
+    {
+        for (unsigned threads = 1; threads <= options.threads; threads = threads < options.threads ? std::min(threads * 2, options.threads) : threads + 1)
+        {
+            if (name == "list")
+            {
+                results.push_back(run<ListAdapter>(name, options, threads));
+            }
+            else if (name == "treap")
+            {
+                results.push_back(run<TreapAdapter>(name, options, threads));
+            }
+            else if (name == "splay")
+            {
+                results.push_back(run<TreeAdapter<cppclass::SplayTree<int>>>(name, options, threads));
+            }
+            else if (name == "compact")
+            {
+                results.push_back(run<TreeAdapter<cppclass::CompactBinarySearchTree<int>>>(name, options, threads));
+            }
+            else if (name == "radix")
+            {
+                results.push_back(run<TreeAdapter<cppclass::RadixTree<int>>>(name, options, threads));
+            }
+            else if (name == "flat")
+            {
+                results.push_back(run<TreeAdapter<cppclass::FlatHashSet<int>>>(name, options, threads));
+            }
+            else if (name == "std::set")
+            {
+                results.push_back(run<StdSetAdapter>(name, options, threads));
+            }
+            else
+            {
+                std::fprintf(stderr, "unknown container %s\n", name.c_str());
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    char dist[32];
+    std::snprintf(dist, sizeof dist, options.zipf > 0.0 ? "zipf:%g" : "uniform", options.zipf);
+    const char *sharing = options.shared ? "shared" : "private";
+    if (options.json)
+    {
+        std::printf("[\n");
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result &r = results[i];
+            std::printf("  {\"container\": \"%s\", \"threads\": %u, \"mix\": \"%u:%u:%u\", \"dist\": \"%s\", "
+                        "\"sharing\": \"%s\", \"ops\": %zu, \"hits\": %zu, \"seconds\": %.6f, \"ops_per_sec\": %.0f, "
+                        "\"p50_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu}%s\n",
+                        r.container.c_str(), r.threads, options.mix[0], options.mix[1], options.mix[2], dist,
+                        sharing, r.ops, r.hits, r.seconds, r.ops / r.seconds, static_cast<unsigned long long>(r.p50),
+                        static_cast<unsigned long long>(r.p99), static_cast<unsigned long long>(r.p999),
+                        i + 1 < results.size() ? "," : "");
+        }
+        std::printf("]\n");
+    }
+    else
+    {
+        std::printf("container,threads,mix,dist,sharing,ops,hits,seconds,ops_per_sec,p50_ns,p99_ns,p999_ns\n");
+        for (const Result &r : results)
+        {
+            std::printf("%s,%u,%u:%u:%u,%s,%s,%zu,%zu,%.6f,%.0f,%llu,%llu,%llu\n", r.container.c_str(), r.threads,
+                        options.mix[0], options.mix[1], options.mix[2], dist, sharing, r.ops, r.hits, r.seconds,
+                        r.ops / r.seconds, static_cast<unsigned long long>(r.p50),
+                        static_cast<unsigned long long>(r.p99), static_cast<unsigned long long>(r.p999));
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,60 @@
+// Compares lab_00's std::pow(x*x + y*y, 0.5), std::hypot and hypot_batch
+// over arrays of 2D points.
+//
+// usage: bench_hw02_hypot [count] [repeats]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "hw02_hypot.h"
+
+template <typename Work>
+static void run(const char *name, size_t count, size_t repeats, const std::vector<double> &out, Work work)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < repeats; ++r)
+    {
+        work();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    double sum = 0.0;
+    for (double v : out)
+    {
+        sum += v;
+    }
+    std::printf("%-14s %6.2f ns/point (sum %.6g)\n", name, elapsed.count() / (count * repeats), sum);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 16;
+    size_t repeats = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> coordinate(-1e3, 1e3);
+    std::vector<double> x(count), y(count), out(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        x[i] = coordinate(rng);
+        y[i] = coordinate(rng);
+    }
+
+    run("pow(c, 0.5)", count, repeats, out, [&] {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = std::pow(x[i] * x[i] + y[i] * y[i], 0.5);
+        }
+    });
+    run("std::hypot", count, repeats, out, [&] {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = std::hypot(x[i], y[i]);
+        }
+    });
+    run("hypot_batch", count, repeats, out, [&] { hypot_batch(x.data(), y.data(), out.data(), count); });
+    return 0;
+}
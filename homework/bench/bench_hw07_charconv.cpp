@@ -0,0 +1,81 @@
+// Compares std::stringstream against the Fraction to_chars/from_chars
+// bulk routines for formatting and parsing "n/d" text.
+//
+// usage: bench_hw07_charconv [count]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "hw07.h"
+#include "hw07_charconv.h"
+
+using cppclass::Fraction;
+
+template <typename Work>
+static void run(const char *name, size_t count, Work work)
+{
+    auto start = std::chrono::steady_clock::now();
+    size_t check = work();
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    std::printf("%-22s %8.1f ns/fraction (check %zu)\n", name, elapsed.count() / count, check);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> numerator(-1000000, 1000000);
+    std::uniform_int_distribution<int> denominator(1, 1000000);
+    std::vector<Fraction> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        values.emplace_back(numerator(rng), denominator(rng));
+    }
+
+    std::string streamed;
+    run("format stringstream", count, [&] {
+        std::ostringstream out;
+        for (const Fraction &f : values)
+        {
+            out << f.numerator() << '/' << f.denominator() << ' ';
+        }
+        streamed = out.str();
+        return streamed.size();
+    });
+
+    std::vector<char> text(count * (cppclass::fraction_max_chars + 1));
+    char *end = text.data();
+    run("format to_chars", count, [&] {
+        end = cppclass::to_chars(text.data(), text.data() + text.size(), values.data(), values.size()).ptr;
+        return static_cast<size_t>(end - text.data());
+    });
+
+    run("parse stringstream", count, [&] {
+        std::istringstream in(streamed);
+        std::vector<Fraction> parsed;
+        parsed.reserve(count);
+        int n;
+        int d;
+        char slash;
+        while (in >> n >> slash >> d)
+        {
+            parsed.emplace_back(n, d);
+        }
+        return parsed.size();
+    });
+
+    run("parse from_chars", count, [&] {
+        std::vector<Fraction> parsed;
+        parsed.reserve(count);
+        cppclass::from_chars(text.data(), end, parsed);
+        return parsed.size();
+    });
+    return 0;
+}
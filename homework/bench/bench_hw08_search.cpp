@@ -0,0 +1,97 @@
+// Explains why searching a linked list is slower than scanning an array by
+// counting cycles, IPC, cache misses and branch misses for each.
+//
+// The list is built twice: once from nodes allocated in list order, and once
+// from nodes linked in shuffled order, which is what a long-lived list that
+// saw many inserts and erases looks like to the cache.
+//
+// usage: bench_hw08_search [elements] [searches]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "hw08.h"
+#include "perf_counters.h"
+
+using Node = cppclass::LinkedList::Node;
+
+static const Node *list_search(const Node *head, int data)
+{
+    for (; head != nullptr; head = head->next)
+    {
+        if (head->data == data)
+        {
+            return head;
+        }
+    }
+    return nullptr;
+}
+
+// Links nodes[order[0]] -> nodes[order[1]] -> ... holding 0, 1, 2, ...
+static Node *link(std::vector<Node> &nodes, const std::vector<size_t> &order)
+{
+    Node *prev = nullptr;
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        Node *node = &nodes[order[i]];
+        node->data = static_cast<int>(i);
+        node->prev = prev;
+        node->next = nullptr;
+        if (prev != nullptr)
+        {
+            prev->next = node;
+        }
+        prev = node;
+    }
+    return order.empty() ? nullptr : &nodes[order[0]];
+}
+
+int main(int argc, char **argv)
+{
+    size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 20;
+    size_t searches = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+
+    std::mt19937 rng(1);
+    std::vector<int> keys(searches);
+    for (int &key : keys)
+    {
+        key = static_cast<int>(rng() % elements);
+    }
+
+    std::vector<int> array(elements);
+    std::iota(array.begin(), array.end(), 0);
+
+    std::vector<size_t> order(elements);
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<Node> sequential_nodes(elements);
+    const Node *sequential = link(sequential_nodes, order);
+    std::shuffle(order.begin(), order.end(), rng);
+    std::vector<Node> shuffled_nodes(elements);
+    const Node *shuffled = link(shuffled_nodes, order);
+
+    cppclass::PerfCounters counters;
+    if (!counters.available())
+    {
+        std::printf("hardware counters unavailable (see /proc/sys/kernel/perf_event_paranoid); timing only\n");
+    }
+    std::printf("%zu elements, %zu searches, values per search\n", elements, searches);
+
+    size_t found = 0;
+    size_t next = 0;
+    counters.measure(searches, [&] {
+        found += std::find(array.begin(), array.end(), keys[next++ % searches]) != array.end();
+    }).print(stdout, "array scan");
+    counters.measure(searches, [&] {
+        found += list_search(sequential, keys[next++ % searches]) != nullptr;
+    }).print(stdout, "list (in order)");
+    counters.measure(searches, [&] {
+        found += list_search(shuffled, keys[next++ % searches]) != nullptr;
+    }).print(stdout, "list (shuffled)");
+    std::printf("found %zu\n", found);
+    return 0;
+}
@@ -0,0 +1,75 @@
+// Compares lookups of absent keys in a CompactBinarySearchTree and a SplayTree
+// with and without a BloomFiltered front.
+//
+// usage: bench_hw09_bloom [keys] [lookups]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "hw09_bloom.h"
+#include "hw09_compact.h"
+#include "hw09_splay.h"
+
+template <typename Set>
+static void run(const char *name, const Set &set, const std::vector<int> &stream)
+{
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int key : stream)
+    {
+        found += set.contains(key);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    std::printf("%-20s %8.1f ns/lookup (found %zu)\n", name, elapsed.count() / stream.size(), found);
+}
+
+template <typename Set>
+static void fill(Set &set, const std::vector<int> &keys)
+{
+    for (int key : keys)
+    {
+        set.insert(key);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1u << 20;
+    size_t queries = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1u << 22;
+
+    // Even keys are stored, odd keys are looked up, so every lookup misses.
+    std::mt19937 rng(42);
+    std::vector<int> keys(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        keys[i] = static_cast<int>(2 * i);
+    }
+    std::shuffle(keys.begin(), keys.end(), rng);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    std::vector<int> stream(queries);
+    for (int &key : stream)
+    {
+        key = static_cast<int>(2 * pick(rng) + 1);
+    }
+
+    cppclass::CompactBinarySearchTree<int> compact;
+    cppclass::BloomFiltered<cppclass::CompactBinarySearchTree<int>> filtered_compact;
+    cppclass::SplayTree<int> splay;
+    cppclass::BloomFiltered<cppclass::SplayTree<int>> filtered_splay;
+    fill(compact, keys);
+    fill(filtered_compact, keys);
+    fill(splay, keys);
+    fill(filtered_splay, keys);
+
+    std::printf("%zu keys, %zu absent lookups, filter %zu KiB\n", n, queries,
+                filtered_compact.filter().bytes() / 1024);
+    run("compact", compact, stream);
+    run("compact+bloom", filtered_compact, stream);
+    run("splay", splay, stream);
+    run("splay+bloom", filtered_splay, stream);
+    return 0;
+}
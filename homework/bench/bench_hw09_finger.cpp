@@ -0,0 +1,61 @@
+// Compares building a hashed treap with bst::insert (a descent from the root
+// per key) and with bst::insert_hint (a descent from the last insertion
+// point) for sorted, nearly sorted and random key streams.
+//
+// usage: bench_hw09_finger [keys] [window]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "hw09.h"
+
+using Node = cppclass::BinarySearchTree<int>::Node;
+
+template <typename Insert>
+static void run(const char *name, const std::vector<int> &stream, Insert insert)
+{
+    Node *root = nullptr;
+    auto start = std::chrono::steady_clock::now();
+    for (int key : stream)
+    {
+        insert(root, new Node(key));
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    std::printf("  %-12s %8.1f ns/insert\n", name, elapsed.count() / stream.size());
+    cppclass::bst::destroy(root);
+}
+
+static void compare(const char *label, const std::vector<int> &stream)
+{
+    std::printf("%s\n", label);
+    run("insert", stream, [](Node *&root, Node *node) { cppclass::bst::insert(root, node); });
+    cppclass::bst::Finger<Node> finger;
+    run("insert_hint", stream, [&](Node *&root, Node *node) { cppclass::bst::insert_hint(root, finger, node); });
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1u << 20;
+    size_t window = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16;
+
+    std::mt19937 rng(42);
+    std::vector<int> stream(n);
+    std::iota(stream.begin(), stream.end(), 0);
+    compare("sorted", stream);
+
+    // Time-ordered keys that arrive slightly out of order: shuffled within small windows.
+    for (size_t i = 0; i + window <= n; i += window)
+    {
+        std::shuffle(stream.begin() + i, stream.begin() + i + window, rng);
+    }
+    compare("nearly sorted", stream);
+
+    std::shuffle(stream.begin(), stream.end(), rng);
+    compare("random", stream);
+    return 0;
+}
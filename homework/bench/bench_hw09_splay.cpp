@@ -0,0 +1,162 @@
+// Compares lookup cost of an unbalanced BST, a hashed treap (balanced via
+// bst::insert) and a SplayTree under Zipfian key popularity.
+//
+// usage: bench_hw09_splay [keys] [lookups] [skew...]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "hw09.h"
+#include "hw09_splay.h"
+#include "zipf.h"
+
+using Node = cppclass::BinarySearchTree<int>::Node;
+
+static void insert_unbalanced(Node *&root, int value)
+{
+    Node **slot = &root;
+    while (*slot != nullptr)
+    {
+        slot = value < (*slot)->data ? &(*slot)->left : &(*slot)->right;
+    }
+    *slot = new Node(value);
+}
+
+static size_t depth_of(const Node *root, int value)
+{
+    size_t depth = 1;
+    while (root != nullptr && root->data != value)
+    {
+        root = value < root->data ? root->left : root->right;
+        ++depth;
+    }
+    return depth;
+}
+
+template <typename Lookup>
+static void run(const char *name, const std::vector<int> &stream, double nodes_per_lookup, Lookup lookup)
+{
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int key : stream)
+    {
+        found += lookup(key);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    std::printf("%-12s %10.1f ns/lookup %8.2f nodes/lookup (found %zu)\n", name,
+                elapsed.count() / stream.size(), nodes_per_lookup, found);
+}
+
+// Same steps as SplayTree::insert, so a tree built with it has the SplayTree's shape.
+static void insert_splay(Node *&root, int value)
+{
+    Node *node = new Node(value);
+    if (root != nullptr)
+    {
+        root = cppclass::bst::splay(root, value);
+        if (value < root->data)
+        {
+            node->left = root->left;
+            node->right = root;
+            root->left = nullptr;
+        }
+        else
+        {
+            node->right = root->right;
+            node->left = root;
+            root->right = nullptr;
+        }
+    }
+    root = node;
+}
+
+// The splay tree reshapes itself on every lookup, so replay the stream on a
+// node-level twin and count the search path each lookup sees before it splays.
+static double mean_splay_depth(Node *&twin, const std::vector<int> &stream)
+{
+    size_t visited = 0;
+    for (int key : stream)
+    {
+        visited += depth_of(twin, key);
+        twin = cppclass::bst::splay(twin, key);
+    }
+    return static_cast<double>(visited) / stream.size();
+}
+
+static double mean_depth(const Node *root, const std::vector<int> &stream)
+{
+    size_t visited = 0;
+    for (int key : stream)
+    {
+        visited += depth_of(root, key);
+    }
+    return static_cast<double>(visited) / stream.size();
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1u << 20;
+    size_t queries = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1u << 22;
+    std::vector<double> skews;
+    for (int i = 3; i < argc; ++i)
+    {
+        skews.push_back(std::strtod(argv[i], nullptr));
+    }
+    if (skews.empty())
+    {
+        skews = {0.0, 0.8, 0.99, 1.2};
+    }
+
+    std::mt19937 rng(42);
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    Node *unbalanced = nullptr;
+    Node *treap = nullptr;
+    cppclass::SplayTree<int> splay;
+    Node *splay_twin = nullptr;
+    for (int k : keys)
+    {
+        insert_unbalanced(unbalanced, k);
+        cppclass::bst::insert(treap, new Node(k));
+        splay.insert(k);
+        insert_splay(splay_twin, k);
+    }
+
+    // Popularity is independent of insertion order; otherwise the hottest keys
+    // would also be the first inserted and sit at the top of the unbalanced tree.
+    std::vector<int> by_popularity(keys);
+    std::shuffle(by_popularity.begin(), by_popularity.end(), rng);
+
+    for (double skew : skews)
+    {
+        cppclass::ZipfDistribution zipf(n, skew);
+        std::vector<int> stream(queries);
+        for (auto &key : stream)
+        {
+            key = by_popularity[zipf(rng)];
+        }
+
+        std::printf("keys=%zu lookups=%zu skew=%.2f\n", n, queries, skew);
+        run("unbalanced", stream, mean_depth(unbalanced, stream), [&](int key) {
+            return cppclass::bst::find(unbalanced, key) != nullptr;
+        });
+        run("treap", stream, mean_depth(treap, stream), [&](int key) {
+            return cppclass::bst::find(treap, key) != nullptr;
+        });
+        // The twin sees the same lookups as splay, so both stay the same shape.
+        run("splay", stream, mean_splay_depth(splay_twin, stream), [&](int key) {
+            return splay.contains(key);
+        });
+    }
+
+    cppclass::bst::destroy(unbalanced);
+    cppclass::bst::destroy(treap);
+    cppclass::bst::destroy(splay_twin);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,73 @@
+// Simulates request-scoped containers: each request builds a few lists and a
+// splay tree, uses them, and throws them away. Compares the default heap,
+// a NodePool kept across requests, and a MonotonicArena released after each
+// request (its per-node deallocations are no-ops).
+//
+// usage: bench_memory_resources [requests] [elements]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+
+#include "hw08_basic.h"
+#include "hw09_splay.h"
+#include "memory_resources.h"
+
+static long handle_request(std::pmr::memory_resource *resource, size_t elements)
+{
+    cppclass::pmr::BasicLinkedList<int> first(resource);
+    cppclass::pmr::BasicLinkedList<int> second(resource);
+    cppclass::pmr::SplayTree<int> index(resource);
+    for (size_t i = 0; i < elements; ++i)
+    {
+        int value = static_cast<int>(i * 2654435761u % 1000003u);
+        first.append(value);
+        second.insert(value);
+        index.insert(value);
+    }
+    long hits = 0;
+    for (size_t i = 0; i < elements; i += 2)
+    {
+        hits += index.contains(static_cast<int>(i));
+    }
+    return hits + static_cast<long>(first.get_size() + second.get_size());
+}
+
+template <typename Request>
+static void run(const char *name, size_t requests, size_t elements, Request request)
+{
+    long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < requests; ++r)
+    {
+        checksum += request(elements);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    std::printf("%-10s %8.1f ns/element (checksum %ld)\n", name,
+                elapsed.count() / (requests * elements * 3), checksum);
+}
+
+int main(int argc, char **argv)
+{
+    size_t requests = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    size_t elements = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+
+    std::printf("requests=%zu elements=%zu\n", requests, elements);
+    run("heap", requests, elements, [](size_t n) {
+        return handle_request(std::pmr::new_delete_resource(), n);
+    });
+
+    cppclass::pmr::NodePool pool;
+    run("pool", requests, elements, [&](size_t n) {
+        return handle_request(&pool, n);
+    });
+
+    cppclass::pmr::MonotonicArena arena(64 * 1024);
+    run("arena", requests, elements, [&](size_t n) {
+        long result = handle_request(&arena, n);
+        arena.release();
+        return result;
+    });
+    return EXIT_SUCCESS;
+}
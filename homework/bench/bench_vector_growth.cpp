@@ -0,0 +1,107 @@
+// Grows a std::vector of containers one push_back at a time and counts how
+// many nodes each reallocation copies. std::vector relocates its elements by
+// move only when the move constructor is noexcept; otherwise it falls back to
+// copying them, which for a node-based container is a full deep copy. Each
+// container is run as-is and wrapped in MayThrowOnMove, which strips noexcept
+// from the move constructor the way the trees were declared before.
+//
+// usage: bench_vector_growth [containers] [elements]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hw08_basic.h"
+#include "hw09_splay.h"
+
+static size_t node_allocations = 0;
+
+template <typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &) {}
+
+    T *allocate(size_t n)
+    {
+        node_allocations += n;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, size_t n)
+    {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U> &) const
+    {
+        return true;
+    }
+};
+
+template <typename Container>
+struct MayThrowOnMove : Container
+{
+    MayThrowOnMove() = default;
+    MayThrowOnMove(const MayThrowOnMove &) = default;
+    MayThrowOnMove(MayThrowOnMove &&other) noexcept(false) : Container(std::move(other)) {}
+};
+
+template <typename Container, typename Fill>
+static void run(const char *name, size_t count, size_t elements, Fill fill)
+{
+    node_allocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<Container> containers;
+        for (size_t i = 0; i < count; ++i)
+        {
+            Container container;
+            fill(container, elements);
+            containers.push_back(std::move(container));
+        }
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    size_t copied = node_allocations - count * elements;
+    std::printf("%-22s noexcept=%d %10.1f ns/push_back %12zu nodes copied (%.2f per element)\n", name,
+                std::is_nothrow_move_constructible_v<Container> ? 1 : 0, elapsed.count() / count, copied,
+                static_cast<double>(copied) / (count * elements));
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1u << 14;
+    size_t elements = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+
+    using List = cppclass::BasicLinkedList<int, CountingAllocator<int>>;
+    using Splay = cppclass::SplayTree<int, CountingAllocator<int>>;
+
+    auto fill_list = [](List &list, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+        {
+            list.append(static_cast<int>(i));
+        }
+    };
+    auto fill_splay = [](Splay &tree, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+        {
+            tree.insert(static_cast<int>(i * 7919 % n));
+        }
+    };
+
+    std::printf("containers=%zu elements=%zu\n", count, elements);
+    run<List>("BasicLinkedList", count, elements, fill_list);
+    run<MayThrowOnMove<List>>("BasicLinkedList (old)", count, elements, fill_list);
+    run<Splay>("SplayTree", count, elements, fill_splay);
+    run<MayThrowOnMove<Splay>>("SplayTree (old)", count, elements, fill_splay);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,179 @@
+#include "perf_counters.h"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cppclass
+{
+    namespace
+    {
+        const char *const names[] = {"cycles", "instructions", "L1d-miss", "LLC-miss", "branch-miss"};
+
+        int64_t now_ns()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+#ifdef __linux__
+        int open_counter(Counter c)
+        {
+            perf_event_attr attr{};
+            attr.size = sizeof attr;
+            attr.type = PERF_TYPE_HARDWARE;
+            switch (c)
+            {
+            case Counter::Cycles:
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case Counter::Instructions:
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case Counter::L1dMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                              | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case Counter::LlcMisses:
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            default:
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            }
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            // With more events than hardware counters the kernel multiplexes;
+            // these let stop() scale the count up to the whole interval
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    double CounterValues::ipc() const
+    {
+        return (*this)[Counter::Instructions] / (*this)[Counter::Cycles];
+    }
+
+    void CounterValues::print(std::FILE *out, const char *name) const
+    {
+        std::fprintf(out, "%-20s %10.1f ns", name, nanoseconds);
+        double i = ipc();
+        if (std::isnan(i))
+        {
+            std::fprintf(out, "  IPC n/a");
+        }
+        else
+        {
+            std::fprintf(out, "  IPC %.2f", i);
+        }
+        for (size_t c = 0; c < static_cast<size_t>(Counter::Count); ++c)
+        {
+            if (std::isnan(values[c]))
+            {
+                std::fprintf(out, "  %s n/a", names[c]);
+            }
+            else
+            {
+                std::fprintf(out, "  %s %.1f", names[c], values[c]);
+            }
+        }
+        std::fprintf(out, "\n");
+    }
+
+    PerfCounters::PerfCounters()
+    : _start_ns(0)
+    {
+        for (size_t c = 0; c < static_cast<size_t>(Counter::Count); ++c)
+        {
+#ifdef __linux__
+            _fds[c] = open_counter(static_cast<Counter>(c));
+#else
+            _fds[c] = -1;
+#endif
+        }
+    }
+
+    PerfCounters::~PerfCounters()
+    {
+#ifdef __linux__
+        for (int fd : _fds)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    bool PerfCounters::available() const
+    {
+        for (int fd : _fds)
+        {
+            if (fd >= 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool PerfCounters::has(Counter c) const
+    {
+        return _fds[static_cast<size_t>(c)] >= 0;
+    }
+
+    void PerfCounters::start()
+    {
+#ifdef __linux__
+        for (int fd : _fds)
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+        _start_ns = now_ns();
+    }
+
+    CounterValues PerfCounters::stop(size_t calls)
+    {
+        int64_t elapsed = now_ns() - _start_ns;
+        double per_call = calls == 0 ? 0.0 : 1.0 / static_cast<double>(calls);
+
+        CounterValues out;
+        out.nanoseconds = static_cast<double>(elapsed) * per_call;
+        for (size_t c = 0; c < static_cast<size_t>(Counter::Count); ++c)
+        {
+            out.values[c] = std::numeric_limits<double>::quiet_NaN();
+#ifdef __linux__
+            if (_fds[c] < 0)
+            {
+                continue;
+            }
+            ioctl(_fds[c], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t reading[3]; // value, time enabled, time running
+            if (read(_fds[c], reading, sizeof reading) == static_cast<ssize_t>(sizeof reading) && reading[2] > 0)
+            {
+                double scale = static_cast<double>(reading[1]) / static_cast<double>(reading[2]);
+                out.values[c] = static_cast<double>(reading[0]) * scale * per_call;
+            }
+#endif
+        }
+        return out;
+    }
+}
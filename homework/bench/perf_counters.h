@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace cppclass
+{
+    // Hardware events PerfCounters can count. Each one opens separately, so
+    // a machine that lacks one (e.g. a VM without LLC events) still gets the rest.
+    enum class Counter
+    {
+        Cycles,
+        Instructions,
+        L1dMisses,     // L1 data cache read misses
+        LlcMisses,     // last-level cache misses
+        BranchMisses,  // mispredicted branches
+        Count
+    };
+
+    // Averages over the calls of one measured region. Counters that could
+    // not be opened read as NaN; nanoseconds is always measured.
+    struct CounterValues
+    {
+        double nanoseconds;
+        double values[static_cast<size_t>(Counter::Count)];
+
+        double operator[](Counter c) const
+        {
+            return values[static_cast<size_t>(c)];
+        }
+
+        // Instructions per cycle, NaN if either is unavailable
+        double ipc() const;
+
+        // Writes one line: name, time and every counter (n/a when unavailable)
+        void print(std::FILE *out, const char *name) const;
+    };
+
+    // Counts hardware events of the calling thread in user space with Linux
+    // perf_event_open. When the kernel refuses (perf_event_paranoid, no PMU,
+    // seccomp) or the platform is not Linux, available() is false and only
+    // wall time is reported, so benchmarks keep one code path.
+    //
+    //     PerfCounters counters;
+    //     counters.measure(1000, [&] { list_search(key); }).print(stdout, "list");
+    class PerfCounters
+    {
+    public:
+        PerfCounters();
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters &) = delete;
+        PerfCounters &operator=(const PerfCounters &) = delete;
+
+        // True if at least one hardware counter opened
+        bool available() const;
+
+        // True if counter c opened
+        bool has(Counter c) const;
+
+        // Zeroes and starts every counter and the clock
+        void start();
+
+        // Stops the counters and returns the totals since start(), divided by calls
+        CounterValues stop(size_t calls = 1);
+
+        // Runs region calls times between start() and stop()
+        template <typename Region>
+        CounterValues measure(size_t calls, Region &&region)
+        {
+            start();
+            for (size_t i = 0; i < calls; ++i)
+            {
+                region();
+            }
+            return stop(calls);
+        }
+
+    private:
+        int _fds[static_cast<size_t>(Counter::Count)];
+        int64_t _start_ns;
+    };
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace cppclass
+{
+    // Draws ranks in [0, n) where rank k has probability proportional to
+    // 1 / (k + 1)^skew. skew == 0 is uniform; skew ~= 1 is the classic
+    // "few hot keys" web/cache workload.
+    class ZipfDistribution
+    {
+    public:
+        ZipfDistribution(size_t n, double skew)
+        : _cdf(n)
+        {
+            double sum = 0.0;
+            for (size_t k = 0; k < n; ++k)
+            {
+                sum += 1.0 / std::pow(static_cast<double>(k + 1), skew);
+                _cdf[k] = sum;
+            }
+            for (auto &c : _cdf)
+            {
+                c /= sum;
+            }
+        }
+
+        template <typename URBG>
+        size_t operator()(URBG &rng) const
+        {
+            double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+            auto it = std::lower_bound(_cdf.begin(), _cdf.end(), u);
+            return std::min(static_cast<size_t>(it - _cdf.begin()), _cdf.size() - 1);
+        }
+
+    private:
+        std::vector<double> _cdf;
+    };
+}
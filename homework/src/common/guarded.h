@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef> // for size_t
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility> // for std::forward
+
+#include "policies.h"
+
+namespace cppclass {
+
+/**
+* @brief Adds a synchronization and a statistics policy to any set-like container.
+*
+* Container needs insert(value), remove(value), contains(value) and size().
+* Lookups take the shared lock unless policy::mutating_reads says they
+* restructure the container. With the default NoLock and NoStats policies both
+* members are empty, every call inlines to the container's own, and
+* sizeof(Guarded<C>) == sizeof(C).
+*
+* Optimistic (version-validated, lock-free) reads are not offered: a reader
+* racing an erase would follow pointers into freed nodes, which needs a memory
+* reclamation scheme these containers do not have.
+*/
+template <typename Container, typename Lock = policy::NoLock, typename Stats = policy::NoStats>
+class Guarded {
+public:
+    /**
+    * @brief Constructs the wrapped container from @p args.
+    */
+    template <typename... Args>
+        requires(!(sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, Guarded> && ...)))
+    explicit Guarded(Args&&... args) : m_container(std::forward<Args>(args)...) {}
+
+    Guarded(const Guarded&) = delete;
+    Guarded& operator=(const Guarded&) = delete;
+
+    template <typename T>
+    bool insert(const T& value)
+    {
+        std::unique_lock<Lock> guard(m_lock);
+        bool inserted = m_container.insert(value);
+        m_stats.record(policy::Operation::Insert, inserted);
+        return inserted;
+    }
+
+    template <typename T>
+    bool remove(const T& value)
+    {
+        std::unique_lock<Lock> guard(m_lock);
+        bool removed = m_container.remove(value);
+        m_stats.record(policy::Operation::Erase, removed);
+        return removed;
+    }
+
+    template <typename T>
+    bool contains(const T& value) const
+    {
+        bool found = read([&](const Container& c) { return c.contains(value); });
+        m_stats.record(policy::Operation::Find, found);
+        return found;
+    }
+
+    size_t size() const
+    {
+        return read([](const Container& c) { return c.size(); });
+    }
+
+    /**
+    * @brief Runs @p f(const Container&) under the read lock and returns its result.
+    */
+    template <typename F>
+    decltype(auto) read(F&& f) const
+    {
+        if constexpr (policy::mutating_reads<Container>::value) {
+            std::unique_lock<Lock> guard(m_lock);
+            return std::forward<F>(f)(static_cast<const Container&>(m_container));
+        } else {
+            std::shared_lock<Lock> guard(m_lock);
+            return std::forward<F>(f)(static_cast<const Container&>(m_container));
+        }
+    }
+
+    /**
+    * @brief Runs @p f(Container&) under the write lock and returns its result.
+    */
+    template <typename F>
+    decltype(auto) write(F&& f)
+    {
+        std::unique_lock<Lock> guard(m_lock);
+        return std::forward<F>(f)(m_container);
+    }
+
+    const Stats& stats() const
+    {
+        return m_stats;
+    }
+
+private:
+    Container m_container;
+    [[no_unique_address]] mutable Lock m_lock;
+    [[no_unique_address]] mutable Stats m_stats;
+};
+
+} // namespace cppclass
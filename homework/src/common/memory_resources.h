@@ -0,0 +1,282 @@
+#pragma once
+
+#include <cstddef>  // for size_t, std::max_align_t
+#include <cstdint>  // for uintptr_t, SIZE_MAX
+#include <memory_resource>
+#include <new>      // for std::bad_alloc
+
+namespace cppclass {
+namespace pmr {
+
+/**
+* @brief Bump-pointer memory resource: allocation is a pointer increment and
+* deallocation does nothing. Everything goes back to the upstream at once, in
+* release() or the destructor.
+*
+* Meant for request-scoped containers: build them on the arena, destroy them
+* (their per-node deallocations cost nothing), then release the arena. Chunks
+* grow geometrically from @p initial_chunk bytes. Not thread-safe.
+*/
+class MonotonicArena : public std::pmr::memory_resource {
+public:
+    explicit MonotonicArena(size_t initial_chunk = 4096,
+                            std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+    : m_upstream(upstream)
+    , m_initial_chunk(initial_chunk < 256 ? 256 : initial_chunk)
+    , m_next_chunk(m_initial_chunk)
+    {}
+
+    /**
+    * @brief Arena that serves from @p buffer first and only then goes upstream.
+    *
+    * The buffer (for example a stack array) is not owned and never freed.
+    */
+    MonotonicArena(void* buffer, size_t size,
+                   std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+    : MonotonicArena(size, upstream)
+    {
+        m_initial = static_cast<char*>(buffer);
+        m_initial_size = size;
+        m_cursor = m_initial;
+        m_end = m_initial + size;
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() override
+    {
+        release();
+    }
+
+    /**
+    * @brief Returns every chunk to the upstream. Nothing allocated from the arena may be used afterwards.
+    */
+    void release()
+    {
+        while (m_chunks != nullptr) {
+            Chunk* next = m_chunks->next;
+            m_upstream->deallocate(m_chunks, m_chunks->size, alignof(std::max_align_t));
+            m_chunks = next;
+        }
+        m_cursor = m_initial;
+        m_end = m_initial + m_initial_size;
+        m_next_chunk = m_initial_chunk;
+        m_allocated = 0;
+    }
+
+    /**
+    * @brief Bytes handed out since construction or the last release().
+    */
+    size_t bytes_allocated() const
+    {
+        return m_allocated;
+    }
+
+    std::pmr::memory_resource* upstream_resource() const
+    {
+        return m_upstream;
+    }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        // Sizes, not pointers, are compared so nothing points past the chunk.
+        if (m_cursor == nullptr || !fits(bytes, alignment)) {
+            grow(bytes, alignment);
+        }
+        char* at = m_cursor + padding(m_cursor, alignment);
+        m_cursor = at + bytes;
+        m_allocated += bytes;
+        return at;
+    }
+
+    bool fits(size_t bytes, size_t alignment) const
+    {
+        size_t space = static_cast<size_t>(m_end - m_cursor);
+        size_t pad = padding(m_cursor, alignment);
+        return pad <= space && bytes <= space - pad;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    static size_t padding(const char* p, size_t alignment)
+    {
+        uintptr_t at = reinterpret_cast<uintptr_t>(p);
+        return (alignment - at % alignment) % alignment;
+    }
+
+    void grow(size_t bytes, size_t alignment)
+    {
+        // Enough for the header, the worst-case padding and the request.
+        if (bytes > SIZE_MAX - sizeof(Chunk) - alignment) {
+            throw std::bad_alloc();
+        }
+        size_t at_least = sizeof(Chunk) + alignment + bytes;
+        size_t size = m_next_chunk;
+        while (size < at_least) {
+            size = size > SIZE_MAX / 2 ? at_least : size * 2;
+        }
+        auto* chunk = static_cast<Chunk*>(m_upstream->allocate(size, alignof(std::max_align_t)));
+        m_next_chunk = size > SIZE_MAX / 2 ? size : size * 2;
+        chunk->next = m_chunks;
+        chunk->size = size;
+        m_chunks = chunk;
+        m_cursor = reinterpret_cast<char*>(chunk + 1);
+        m_end = reinterpret_cast<char*>(chunk) + size;
+    }
+
+    std::pmr::memory_resource* m_upstream;
+    size_t m_initial_chunk;
+    size_t m_next_chunk;
+    Chunk* m_chunks = nullptr;
+    char* m_initial = nullptr;
+    size_t m_initial_size = 0;
+    char* m_cursor = nullptr;
+    char* m_end = nullptr;
+    size_t m_allocated = 0;
+};
+
+/**
+* @brief Memory resource with one free list per 16-byte size class up to 256 bytes.
+*
+* Container nodes are small and all of one size, so each class carves its
+* blocks out of slabs of @p slab_size bytes and recycles freed blocks
+* without going upstream. A list or tree node lands in one class and costs
+* exactly its rounded-up size: no per-block header. Larger or over-aligned
+* requests pass straight to the upstream. Slabs are returned in release()
+* or the destructor. Not thread-safe.
+*/
+class NodePool : public std::pmr::memory_resource {
+public:
+    static constexpr size_t granularity = 16;
+    static constexpr size_t max_pooled = 256;
+
+    explicit NodePool(size_t slab_size = 16384,
+                      std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+    : m_upstream(upstream)
+    , m_slab_size(slab_size < 2 * max_pooled ? 2 * max_pooled : slab_size)
+    {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool() override
+    {
+        release();
+    }
+
+    /**
+    * @brief Returns every slab to the upstream. Pooled blocks may not be used afterwards.
+    */
+    void release()
+    {
+        while (m_slabs != nullptr) {
+            Slab* next = m_slabs->next;
+            m_upstream->deallocate(m_slabs, m_slab_size, alignof(std::max_align_t));
+            m_slabs = next;
+        }
+        for (auto& size_class : m_classes) {
+            size_class = SizeClass{};
+        }
+    }
+
+    /**
+    * @brief Number of slabs currently taken from the upstream.
+    */
+    size_t slab_count() const
+    {
+        size_t count = 0;
+        for (const Slab* slab = m_slabs; slab != nullptr; slab = slab->next) {
+            ++count;
+        }
+        return count;
+    }
+
+    std::pmr::memory_resource* upstream_resource() const
+    {
+        return m_upstream;
+    }
+
+private:
+    struct Slab {
+        Slab* next;
+    };
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct SizeClass {
+        FreeBlock* free = nullptr;
+        char* cursor = nullptr;
+        char* end = nullptr;
+    };
+
+    static bool pooled(size_t bytes, size_t alignment)
+    {
+        return bytes <= max_pooled && alignment <= granularity;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        if (!pooled(bytes, alignment)) {
+            return m_upstream->allocate(bytes, alignment);
+        }
+        size_t index = bytes == 0 ? 0 : (bytes - 1) / granularity;
+        SizeClass& size_class = m_classes[index];
+        if (size_class.free != nullptr) {
+            FreeBlock* block = size_class.free;
+            size_class.free = block->next;
+            return block;
+        }
+        size_t block_size = (index + 1) * granularity;
+        // As in MonotonicArena, sizes are compared so no pointer runs past the slab.
+        if (size_class.cursor == nullptr || block_size > static_cast<size_t>(size_class.end - size_class.cursor)) {
+            auto* slab = static_cast<Slab*>(m_upstream->allocate(m_slab_size, alignof(std::max_align_t)));
+            slab->next = m_slabs;
+            m_slabs = slab;
+            // The header takes one granule so blocks stay 16-byte aligned.
+            size_class.cursor = reinterpret_cast<char*>(slab) + granularity;
+            size_class.end = reinterpret_cast<char*>(slab) + m_slab_size;
+        }
+        void* block = size_class.cursor;
+        size_class.cursor += block_size;
+        return block;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        if (!pooled(bytes, alignment)) {
+            m_upstream->deallocate(p, bytes, alignment);
+            return;
+        }
+        SizeClass& size_class = m_classes[bytes == 0 ? 0 : (bytes - 1) / granularity];
+        auto* block = static_cast<FreeBlock*>(p);
+        block->next = size_class.free;
+        size_class.free = block;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* m_upstream;
+    size_t m_slab_size;
+    Slab* m_slabs = nullptr;
+    SizeClass m_classes[max_pooled / granularity];
+};
+
+} // namespace pmr
+} // namespace cppclass
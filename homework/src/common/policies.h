@@ -0,0 +1,227 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
+#include <memory>   // for std::allocator_traits
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>  // for std::forward
+
+namespace cppclass {
+namespace policy {
+
+/**
+* @brief Allocates and constructs one container node type through any standard Allocator.
+*
+* Containers take a plain Allocator template parameter (std::allocator<T> by
+* default) and keep one of these, which rebinds it to their node type. With a
+* stateless allocator it is an empty class and, stored [[no_unique_address]],
+* costs nothing.
+*/
+template <typename Node, typename Alloc>
+class NodeAllocator {
+public:
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using traits = std::allocator_traits<allocator_type>;
+
+    NodeAllocator() = default;
+
+    template <typename Other>
+    explicit NodeAllocator(const Other& alloc) : m_alloc(alloc) {}
+
+    /**
+    * @brief Allocates a node and constructs it from @p args.
+    */
+    template <typename... Args>
+    Node* create(Args&&... args)
+    {
+        Node* node = traits::allocate(m_alloc, 1);
+        try {
+            traits::construct(m_alloc, node, std::forward<Args>(args)...);
+        } catch (...) {
+            traits::deallocate(m_alloc, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    /**
+    * @brief Destroys and frees a node made by create().
+    */
+    void destroy(Node* node)
+    {
+        traits::destroy(m_alloc, node);
+        traits::deallocate(m_alloc, node, 1);
+    }
+
+    const allocator_type& get() const
+    {
+        return m_alloc;
+    }
+
+    /**
+    * @brief The allocator a copy of the owning container should use.
+    */
+    NodeAllocator select_on_copy() const
+    {
+        return NodeAllocator(traits::select_on_container_copy_construction(m_alloc));
+    }
+
+    // Propagation rules, as std containers apply them. Allocators such as
+    // std::pmr::polymorphic_allocator stay with their container on copy and
+    // move assignment, and cannot even be assigned.
+    using propagate_on_copy = typename traits::propagate_on_container_copy_assignment;
+    using propagate_on_move = typename traits::propagate_on_container_move_assignment;
+    using propagate_on_swap = typename traits::propagate_on_container_swap;
+
+    /**
+    * @brief True if a container can take over nodes made by @p other on move assignment.
+    */
+    static constexpr bool adopts_on_move = propagate_on_move::value || traits::is_always_equal::value;
+
+    /**
+    * @brief Whether nodes made through @p other can be freed through this one.
+    */
+    bool operator==(const NodeAllocator& other) const
+    {
+        return m_alloc == other.m_alloc;
+    }
+
+    /**
+    * @brief Takes @p other's allocator if @p Propagate says the allocator follows the contents.
+    */
+    template <typename Propagate>
+    void propagate(const NodeAllocator& other)
+    {
+        if constexpr (Propagate::value) {
+            m_alloc = other.m_alloc;
+        }
+    }
+
+    /**
+    * @brief Swaps allocators if they propagate on swap; otherwise they must already be equal.
+    */
+    void swap(NodeAllocator& other) noexcept
+    {
+        if constexpr (propagate_on_swap::value) {
+            using std::swap;
+            swap(m_alloc, other.m_alloc);
+        }
+    }
+
+private:
+    [[no_unique_address]] allocator_type m_alloc;
+};
+
+/**
+* @brief Synchronization policy that does nothing; the default for single-threaded use.
+*
+* Every lock policy is both Lockable and SharedLockable, so containers can use
+* std::unique_lock for writes and std::shared_lock for reads with any of them.
+*/
+struct NoLock {
+    void lock() {}
+    void unlock() {}
+    bool try_lock() { return true; }
+    void lock_shared() {}
+    void unlock_shared() {}
+    bool try_lock_shared() { return true; }
+};
+
+/**
+* @brief One std::mutex; readers are serialized with writers and with each other.
+*/
+class MutexLock {
+public:
+    void lock() { m_mutex.lock(); }
+    void unlock() { m_mutex.unlock(); }
+    bool try_lock() { return m_mutex.try_lock(); }
+    void lock_shared() { m_mutex.lock(); }
+    void unlock_shared() { m_mutex.unlock(); }
+    bool try_lock_shared() { return m_mutex.try_lock(); }
+
+private:
+    std::mutex m_mutex;
+};
+
+/**
+* @brief A std::shared_mutex; readers run concurrently with each other.
+*/
+class SharedMutexLock {
+public:
+    void lock() { m_mutex.lock(); }
+    void unlock() { m_mutex.unlock(); }
+    bool try_lock() { return m_mutex.try_lock(); }
+    void lock_shared() { m_mutex.lock_shared(); }
+    void unlock_shared() { m_mutex.unlock_shared(); }
+    bool try_lock_shared() { return m_mutex.try_lock_shared(); }
+
+private:
+    std::shared_mutex m_mutex;
+};
+
+/**
+* @brief Container operations a statistics policy is told about.
+*/
+enum class Operation {
+    Find,
+    Insert,
+    Erase,
+};
+
+/**
+* @brief Statistics policy that records nothing; the default.
+*/
+struct NoStats {
+    void record(Operation, bool) {}
+};
+
+/**
+* @brief Counts calls and hits (found, inserted or erased) per operation.
+*
+* Counters are relaxed atomics, so one instance can be shared by threads that
+* hold only a read lock.
+*/
+class CountingStats {
+public:
+    void record(Operation op, bool hit)
+    {
+        m_calls[index(op)].fetch_add(1, std::memory_order_relaxed);
+        if (hit) {
+            m_hits[index(op)].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t calls(Operation op) const
+    {
+        return m_calls[index(op)].load(std::memory_order_relaxed);
+    }
+
+    uint64_t hits(Operation op) const
+    {
+        return m_hits[index(op)].load(std::memory_order_relaxed);
+    }
+
+private:
+    static size_t index(Operation op)
+    {
+        return static_cast<size_t>(op);
+    }
+
+    std::atomic<uint64_t> m_calls[3] = {};
+    std::atomic<uint64_t> m_hits[3] = {};
+};
+
+/**
+* @brief True for containers whose lookups restructure them (e.g. SplayTree).
+*
+* Wrappers such as Guarded must then take the write lock for lookups too.
+* Specialize next to such a container.
+*/
+template <typename Container>
+struct mutating_reads : std::false_type {};
+
+} // namespace policy
+} // namespace cppclass
@@ -0,0 +1,209 @@
+#include "hw02_hypot.h"
+
+#include <cfloat>
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HW02_HYPOT_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    // A sum of squares outside [DBL_MIN, DBL_MAX] (or NaN) has lost bits to
+    // underflow, overflowed, or came from inf/NaN inputs
+    bool in_range(double s)
+    {
+        return s >= DBL_MIN && s <= DBL_MAX;
+    }
+
+    double hypot2(double x, double y)
+    {
+        double s = x * x + y * y;
+        return in_range(s) ? std::sqrt(s) : std::hypot(x, y);
+    }
+
+    double hypot3(double x, double y, double z)
+    {
+        double s = x * x + y * y + z * z;
+        return in_range(s) ? std::sqrt(s) : std::hypot(x, y, z);
+    }
+
+    // Redoes the lanes set in bad with std::hypot. xs, ys, zs hold the
+    // inputs of the block (zs is nullptr in 2D) and result its lengths.
+    void fix_lanes(const double *xs, const double *ys, const double *zs, double *result, int bad, int lanes)
+    {
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            if (bad & (1 << lane))
+            {
+                result[lane] = zs == nullptr ? std::hypot(xs[lane], ys[lane])
+                                             : std::hypot(xs[lane], ys[lane], zs[lane]);
+            }
+        }
+    }
+
+#ifdef HW02_HYPOT_AVX2
+    bool have_avx2()
+    {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    // Target "avx2" without "fma", so x*x + y*y rounds the same way as the
+    // scalar code
+    __attribute__((target("avx2"))) size_t hypot2_avx2(const double *x, const double *y, double *out, size_t count)
+    {
+        const __m256d low = _mm256_set1_pd(DBL_MIN);
+        const __m256d high = _mm256_set1_pd(DBL_MAX);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d vx = _mm256_loadu_pd(x + i);
+            __m256d vy = _mm256_loadu_pd(y + i);
+            __m256d s = _mm256_add_pd(_mm256_mul_pd(vx, vx), _mm256_mul_pd(vy, vy));
+            __m256d ok = _mm256_and_pd(_mm256_cmp_pd(s, low, _CMP_GE_OQ), _mm256_cmp_pd(s, high, _CMP_LE_OQ));
+            __m256d r = _mm256_sqrt_pd(s);
+            int bad = ~_mm256_movemask_pd(ok) & 0xF;
+            if (bad != 0)
+            {
+                double xs[4], ys[4], rs[4];
+                _mm256_storeu_pd(xs, vx);
+                _mm256_storeu_pd(ys, vy);
+                _mm256_storeu_pd(rs, r);
+                fix_lanes(xs, ys, nullptr, rs, bad, 4);
+                r = _mm256_loadu_pd(rs);
+            }
+            _mm256_storeu_pd(out + i, r);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) size_t hypot3_avx2(const double *x, const double *y, const double *z,
+                                                       double *out, size_t count)
+    {
+        const __m256d low = _mm256_set1_pd(DBL_MIN);
+        const __m256d high = _mm256_set1_pd(DBL_MAX);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d vx = _mm256_loadu_pd(x + i);
+            __m256d vy = _mm256_loadu_pd(y + i);
+            __m256d vz = _mm256_loadu_pd(z + i);
+            __m256d s = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vx, vx), _mm256_mul_pd(vy, vy)),
+                                      _mm256_mul_pd(vz, vz));
+            __m256d ok = _mm256_and_pd(_mm256_cmp_pd(s, low, _CMP_GE_OQ), _mm256_cmp_pd(s, high, _CMP_LE_OQ));
+            __m256d r = _mm256_sqrt_pd(s);
+            int bad = ~_mm256_movemask_pd(ok) & 0xF;
+            if (bad != 0)
+            {
+                double xs[4], ys[4], zs[4], rs[4];
+                _mm256_storeu_pd(xs, vx);
+                _mm256_storeu_pd(ys, vy);
+                _mm256_storeu_pd(zs, vz);
+                _mm256_storeu_pd(rs, r);
+                fix_lanes(xs, ys, zs, rs, bad, 4);
+                r = _mm256_loadu_pd(rs);
+            }
+            _mm256_storeu_pd(out + i, r);
+        }
+        return i;
+    }
+#endif
+
+#ifdef __SSE2__
+    size_t hypot2_sse2(const double *x, const double *y, double *out, size_t count)
+    {
+        const __m128d low = _mm_set1_pd(DBL_MIN);
+        const __m128d high = _mm_set1_pd(DBL_MAX);
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d vx = _mm_loadu_pd(x + i);
+            __m128d vy = _mm_loadu_pd(y + i);
+            __m128d s = _mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy));
+            __m128d ok = _mm_and_pd(_mm_cmpge_pd(s, low), _mm_cmple_pd(s, high));
+            __m128d r = _mm_sqrt_pd(s);
+            int bad = ~_mm_movemask_pd(ok) & 0x3;
+            if (bad != 0)
+            {
+                double xs[2], ys[2], rs[2];
+                _mm_storeu_pd(xs, vx);
+                _mm_storeu_pd(ys, vy);
+                _mm_storeu_pd(rs, r);
+                fix_lanes(xs, ys, nullptr, rs, bad, 2);
+                r = _mm_loadu_pd(rs);
+            }
+            _mm_storeu_pd(out + i, r);
+        }
+        return i;
+    }
+
+    size_t hypot3_sse2(const double *x, const double *y, const double *z, double *out, size_t count)
+    {
+        const __m128d low = _mm_set1_pd(DBL_MIN);
+        const __m128d high = _mm_set1_pd(DBL_MAX);
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d vx = _mm_loadu_pd(x + i);
+            __m128d vy = _mm_loadu_pd(y + i);
+            __m128d vz = _mm_loadu_pd(z + i);
+            __m128d s = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy)), _mm_mul_pd(vz, vz));
+            __m128d ok = _mm_and_pd(_mm_cmpge_pd(s, low), _mm_cmple_pd(s, high));
+            __m128d r = _mm_sqrt_pd(s);
+            int bad = ~_mm_movemask_pd(ok) & 0x3;
+            if (bad != 0)
+            {
+                double xs[2], ys[2], zs[2], rs[2];
+                _mm_storeu_pd(xs, vx);
+                _mm_storeu_pd(ys, vy);
+                _mm_storeu_pd(zs, vz);
+                _mm_storeu_pd(rs, r);
+                fix_lanes(xs, ys, zs, rs, bad, 2);
+                r = _mm_loadu_pd(rs);
+            }
+            _mm_storeu_pd(out + i, r);
+        }
+        return i;
+    }
+#endif
+}
+
+void hypot_batch(const double *x, const double *y, double *out, size_t count)
+{
+    size_t i = 0;
+#ifdef HW02_HYPOT_AVX2
+    if (have_avx2())
+    {
+        i = hypot2_avx2(x, y, out, count);
+    }
+#endif
+#ifdef __SSE2__
+    i += hypot2_sse2(x + i, y + i, out + i, count - i);
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = hypot2(x[i], y[i]);
+    }
+}
+
+void hypot_batch(const double *x, const double *y, const double *z, double *out, size_t count)
+{
+    size_t i = 0;
+#ifdef HW02_HYPOT_AVX2
+    if (have_avx2())
+    {
+        i = hypot3_avx2(x, y, z, out, count);
+    }
+#endif
+#ifdef __SSE2__
+    i += hypot3_sse2(x + i, y + i, z + i, out + i, count - i);
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = hypot3(x[i], y[i], z[i]);
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+
+// Pre-conditions: x, y and out each point to count values; out may alias
+//                 x or y
+// Post-conditions: out[i] holds the length of the vector (x[i], y[i])
+//
+//          Computes sqrt(x*x + y*y) directly, which is within about one ulp
+//          of the exact length. Only elements whose sum of squares would
+//          overflow, underflow or is not finite fall back to std::hypot,
+//          which rescales, so they get the same answer (including inf and
+//          NaN handling) as std::hypot.
+//
+//          Uses AVX2 (four lanes) when the CPU supports it, checked once at
+//          run time, else SSE2 (two lanes) where available.
+void hypot_batch(const double *x, const double *y, double *out, size_t count);
+
+// Pre-conditions: x, y, z and out each point to count values; out may alias
+//                 any input
+// Post-conditions: out[i] holds the length of the vector (x[i], y[i], z[i]),
+//                  with the same accuracy and fallback as above
+void hypot_batch(const double *x, const double *y, const double *z, double *out, size_t count);
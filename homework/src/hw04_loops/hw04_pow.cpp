@@ -0,0 +1,144 @@
+#include "hw04_pow.h"
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    // |n| without overflowing on the most negative value
+    unsigned long long magnitude(long long n)
+    {
+        return n < 0 ? 0 - static_cast<unsigned long long>(n) : static_cast<unsigned long long>(n);
+    }
+
+    constexpr int pow10_min = -323;
+    constexpr int pow10_max = 308;
+}
+
+double powi(double x, long long n)
+{
+    unsigned long long m = magnitude(n);
+    double result = 1.0;
+    while (m != 0)
+    {
+        if (m & 1)
+        {
+            result *= x;
+        }
+        x *= x;
+        m >>= 1;
+    }
+    return n < 0 ? 1.0 / result : result;
+}
+
+double pow10i(int n)
+{
+    // Parsing "1e<n>" gives the correctly rounded value, unlike repeated
+    // multiplication or std::pow
+    static const std::array<double, pow10_max - pow10_min + 1> table = [] {
+        std::array<double, pow10_max - pow10_min + 1> values{};
+        for (int e = pow10_min; e <= pow10_max; ++e)
+        {
+            char text[8];
+            int length = std::snprintf(text, sizeof text, "1e%d", e);
+            std::from_chars(text, text + length, values[e - pow10_min]);
+        }
+        return values;
+    }();
+
+    if (n < pow10_min)
+    {
+        return 0.0;
+    }
+    if (n > pow10_max)
+    {
+        return HUGE_VAL;
+    }
+    return table[n - pow10_min];
+}
+
+void powi_batch(const double *base, const int *exponent, double *out, size_t count)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128d one = _mm_set1_pd(1.0);
+    for (; i + 2 <= count; i += 2)
+    {
+        unsigned long long m0 = magnitude(exponent[i]);
+        unsigned long long m1 = magnitude(exponent[i + 1]);
+        __m128d x = _mm_loadu_pd(base + i);
+        __m128d result = one;
+        while ((m0 | m1) != 0)
+        {
+            // Lanes whose bit is clear multiply by exactly 1.0, which keeps
+            // their result identical to the scalar loop
+            __m128d take = _mm_castsi128_pd(_mm_set_epi64x(-static_cast<long long>(m1 & 1),
+                                                           -static_cast<long long>(m0 & 1)));
+            result = _mm_mul_pd(result, _mm_or_pd(_mm_and_pd(take, x), _mm_andnot_pd(take, one)));
+            x = _mm_mul_pd(x, x);
+            m0 >>= 1;
+            m1 >>= 1;
+        }
+        __m128d negative = _mm_castsi128_pd(_mm_set_epi64x(-static_cast<long long>(exponent[i + 1] < 0),
+                                                           -static_cast<long long>(exponent[i] < 0)));
+        __m128d inverse = _mm_div_pd(one, result);
+        _mm_storeu_pd(out + i, _mm_or_pd(_mm_and_pd(negative, inverse), _mm_andnot_pd(negative, result)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = powi(base[i], exponent[i]);
+    }
+}
+
+void powi_batch(const double *base, long long exponent, double *out, size_t count)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128d one = _mm_set1_pd(1.0);
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d x = _mm_loadu_pd(base + i);
+        __m128d result = one;
+        for (unsigned long long m = magnitude(exponent); m != 0; m >>= 1)
+        {
+            if (m & 1)
+            {
+                result = _mm_mul_pd(result, x);
+            }
+            x = _mm_mul_pd(x, x);
+        }
+        if (exponent < 0)
+        {
+            result = _mm_div_pd(one, result);
+        }
+        _mm_storeu_pd(out + i, result);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = powi(base[i], exponent);
+    }
+}
+
+double CachedPow::operator()(double base, double exponent)
+{
+    // Bit patterns, so -0.0 and +0.0 (which pow can tell apart) are different arguments
+    if (!_valid || std::bit_cast<uint64_t>(base) != std::bit_cast<uint64_t>(_base)
+        || std::bit_cast<uint64_t>(exponent) != std::bit_cast<uint64_t>(_exponent))
+    {
+        _base = base;
+        _exponent = exponent;
+        _result = std::pow(base, exponent);
+        _valid = true;
+    }
+    return _result;
+}
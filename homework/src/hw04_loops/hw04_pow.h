@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+
+// Pre-conditions: none
+// Post-conditions: none
+// Returns: x raised to the integer power n, by repeated squaring
+//
+//          e.g. x=2.0, n=10 -> 1024.0
+//               x=2.0, n=-3 -> 0.125
+//               x=anything, n=0 -> 1.0 (as std::pow, even for NaN)
+//
+//          Takes at most 2 * log2(|n|) + 1 multiplications, plus one
+//          division when n < 0. Every squaring doubles the relative error
+//          already in x^(2^j), so while no intermediate overflows or goes
+//          subnormal the error is below about (|n| + 1) * 2^-53. Results
+//          are exact when every intermediate is representable (e.g. 2^n);
+//          prefer std::pow when |n| is large and full accuracy matters.
+double powi(double x, long long n);
+
+// Pre-conditions: none
+// Post-conditions: none
+// Returns: 10^n correctly rounded, read from a table built on first use
+//
+//          e.g. n=3 -> 1000.0
+//               n=-1 -> 0.1 (the double nearest to it)
+//               n=309 -> inf, n=-324 -> 0.0
+double pow10i(int n);
+
+// Pre-conditions: base, exponent and out each point to count values;
+//                 out may alias base
+// Post-conditions: out[i] == powi(base[i], exponent[i]) bit for bit, so the
+//                  powi error bound applies to every element
+//
+//          Works on two elements at a time with SSE2 where it is available.
+void powi_batch(const double *base, const int *exponent, double *out, size_t count);
+
+// Same as above with one exponent shared by every element
+void powi_batch(const double *base, long long exponent, double *out, size_t count);
+
+// Memoizes std::pow for callers that raise the same base to the same
+// exponent over and over, like a per-tick pow(10, acceleration) where the
+// acceleration rarely changes. A repeated call costs two comparisons of the
+// arguments' bit patterns; a new (base, exponent) pair is computed with
+// std::pow, so results are identical, down to the sign of an infinity.
+class CachedPow
+{
+public:
+    // Pre-conditions: none
+    // Post-conditions: the arguments and result are remembered
+    // Returns: std::pow(base, exponent)
+    double operator()(double base, double exponent);
+
+private:
+    bool _valid = false;
+    double _base = 0.0;
+    double _exponent = 0.0;
+    double _result = 0.0;
+};
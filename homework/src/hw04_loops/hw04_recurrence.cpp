@@ -0,0 +1,157 @@
+#include "hw04_recurrence.h"
+
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
+// With modulus <= 2^32 every residue is below 2^32, so a residue product plus
+// one residue still fits in 64 bits and a sum of products fits in 128 bits.
+
+LinearRecurrence::LinearRecurrence(std::vector<uint64_t> coefficients, std::vector<uint64_t> initial,
+                                   uint64_t modulus)
+: _coefficients(std::move(coefficients))
+, _initial(std::move(initial))
+, _modulus(modulus)
+{
+    if (_coefficients.empty() || _coefficients.size() != _initial.size())
+    {
+        throw std::invalid_argument("Need as many initial terms as coefficients, and at least one");
+    }
+    if (_modulus == 0 || _modulus > (uint64_t(1) << 32))
+    {
+        throw std::invalid_argument("Modulus must be in [1, 2^32]");
+    }
+    for (uint64_t &c : _coefficients)
+    {
+        c %= _modulus;
+    }
+    for (uint64_t &a : _initial)
+    {
+        a %= _modulus;
+    }
+}
+
+uint64_t LinearRecurrence::term(uint64_t n) const
+{
+    return terms({n})[0];
+}
+
+std::vector<uint64_t> LinearRecurrence::terms(const std::vector<uint64_t> &indices) const
+{
+    size_t k = order();
+    uint64_t largest = 0;
+    for (uint64_t n : indices)
+    {
+        largest = n > largest ? n : largest;
+    }
+
+    std::vector<Poly> powers;
+    if (largest >= k)
+    {
+        powers = _powers_of_two(std::bit_width(largest));
+    }
+
+    std::vector<uint64_t> out;
+    out.reserve(indices.size());
+    for (uint64_t n : indices)
+    {
+        if (n < k)
+        {
+            out.push_back(_initial[n]);
+            continue;
+        }
+        Poly result;
+        for (size_t bit = 0; n != 0; ++bit, n >>= 1)
+        {
+            if (n & 1)
+            {
+                result = result.empty() ? powers[bit] : _multiply(result, powers[bit]);
+            }
+        }
+        out.push_back(_combine(result));
+    }
+    return out;
+}
+
+size_t LinearRecurrence::order() const
+{
+    return _coefficients.size();
+}
+
+uint64_t LinearRecurrence::modulus() const
+{
+    return _modulus;
+}
+
+LinearRecurrence::Poly LinearRecurrence::_multiply(const Poly &a, const Poly &b) const
+{
+    size_t k = order();
+    std::vector<unsigned __int128> wide(2 * k - 1, 0);
+    for (size_t i = 0; i < k; ++i)
+    {
+        if (a[i] == 0)
+        {
+            continue;
+        }
+        for (size_t j = 0; j < k; ++j)
+        {
+            wide[i + j] += static_cast<unsigned __int128>(a[i] * b[j]);
+        }
+    }
+
+    Poly product(2 * k - 1);
+    for (size_t i = 0; i < product.size(); ++i)
+    {
+        product[i] = static_cast<uint64_t>(wide[i] % _modulus);
+    }
+    // Fold x^d, highest first, using x^k = c[0] x^(k-1) + ... + c[k-1]
+    for (size_t d = 2 * k - 2; d >= k; --d)
+    {
+        uint64_t t = product[d];
+        if (t == 0)
+        {
+            continue;
+        }
+        for (size_t j = 0; j < k; ++j)
+        {
+            uint64_t &slot = product[d - 1 - j];
+            slot = (slot + t * _coefficients[j]) % _modulus;
+        }
+    }
+    product.resize(k);
+    return product;
+}
+
+uint64_t LinearRecurrence::_combine(const Poly &p) const
+{
+    unsigned __int128 sum = 0;
+    for (size_t i = 0; i < order(); ++i)
+    {
+        sum += p[i] * _initial[i];
+    }
+    return static_cast<uint64_t>(sum % _modulus);
+}
+
+std::vector<LinearRecurrence::Poly> LinearRecurrence::_powers_of_two(size_t bits) const
+{
+    size_t k = order();
+    std::vector<Poly> powers;
+    powers.reserve(bits);
+
+    // x itself, already reduced when k == 1
+    Poly x(k, 0);
+    if (k == 1)
+    {
+        x[0] = _coefficients[0];
+    }
+    else
+    {
+        x[1] = 1 % _modulus;
+    }
+    powers.push_back(x);
+    while (powers.size() < bits)
+    {
+        powers.push_back(_multiply(powers.back(), powers.back()));
+    }
+    return powers;
+}
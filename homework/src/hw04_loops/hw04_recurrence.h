@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A k-th order linear recurrence evaluated modulo m:
+//
+//     a(n) = c[0] * a(n-1) + c[1] * a(n-2) + ... + c[k-1] * a(n-k)   (mod m)
+//
+// with the first k terms a(0) .. a(k-1) given. fibonacci is the case
+// c = {1, 1}, a = {0, 1}; tribonacci is c = {1, 1, 1}, a = {0, 0, 1}.
+//
+// Terms are computed with Kitamasa's method: x^n is reduced modulo the
+// characteristic polynomial x^k - c[0] x^(k-1) - ... - c[k-1], and the k
+// remainder coefficients weight the initial terms. Each polynomial product
+// costs O(k^2), so a single term takes O(k^2 log n) instead of O(k n).
+class LinearRecurrence
+{
+public:
+    // Pre-conditions: coefficients and initial have the same size k >= 1,
+    //                 and 1 <= modulus <= 2^32, otherwise throws
+    //                 std::invalid_argument
+    // Post-conditions: coefficients and initial terms are stored reduced
+    //                  modulo modulus
+    LinearRecurrence(std::vector<uint64_t> coefficients, std::vector<uint64_t> initial, uint64_t modulus);
+
+    // Pre-conditions: none
+    // Post-conditions: none
+    // Returns: a(n) mod modulus
+    //
+    //          e.g. for fibonacci mod 2^32, n=10 -> 55
+    //                                       n=100 -> 3314859971
+    uint64_t term(uint64_t n) const;
+
+    // Pre-conditions: none
+    // Post-conditions: none
+    // Returns: a(indices[i]) mod modulus for every i, in the same order
+    //
+    //          x^(2^j) is reduced once for every bit j that any query needs
+    //          and shared between all of them, so each further query costs
+    //          one polynomial product per set bit of its index.
+    std::vector<uint64_t> terms(const std::vector<uint64_t> &indices) const;
+
+    // Returns: k, the number of previous terms each term depends on
+    size_t order() const;
+
+    // Returns: the modulus every term is reduced by
+    uint64_t modulus() const;
+
+private:
+    // A polynomial of degree < k, coefficient of x^i at index i
+    using Poly = std::vector<uint64_t>;
+
+    // Returns a * b modulo the characteristic polynomial
+    Poly _multiply(const Poly &a, const Poly &b) const;
+
+    // Returns sum of p[i] * a(i)
+    uint64_t _combine(const Poly &p) const;
+
+    // Returns x^(2^j) for j in [0, bits)
+    std::vector<Poly> _powers_of_two(size_t bits) const;
+
+    std::vector<uint64_t> _coefficients;
+    std::vector<uint64_t> _initial;
+    uint64_t _modulus;
+};
@@ -1,6 +1,9 @@
 #include "hw07.h"
 
 #include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
 #include <stdexcept>
 
 namespace cppclass
@@ -59,4 +62,116 @@ namespace cppclass
     {
         return false;
     }
+
+    Fraction Fraction::from_double(double x, int max_denominator)
+    {
+        if (std::isnan(x) || std::isinf(x))
+        {
+            throw std::invalid_argument("Cannot approximate NaN or infinity");
+        }
+        if (max_denominator < 1)
+        {
+            throw std::invalid_argument("max_denominator must be at least 1");
+        }
+
+        // x == sign * mantissa * 2^exponent exactly, with mantissa < 2^53
+        int exponent;
+        double fraction = std::frexp(std::fabs(x), &exponent);
+        uint64_t mantissa = static_cast<uint64_t>(std::ldexp(fraction, 53));
+        exponent -= 53;
+        int sign = x < 0 ? -1 : 1;
+
+        if (mantissa == 0)
+        {
+            return Fraction(0, 1);
+        }
+        while ((mantissa & 1) == 0 && exponent < 0)
+        {
+            mantissa >>= 1;
+            ++exponent;
+        }
+        if (exponent >= 0)
+        {
+            if (exponent > 31 || mantissa > (static_cast<uint64_t>(INT_MAX) >> exponent))
+            {
+                throw std::overflow_error("Value does not fit in a Fraction");
+            }
+            return Fraction(sign * static_cast<int>(mantissa << exponent), 1);
+        }
+        // Below 2^-34, x is nearer to 0 than to 1 / max_denominator
+        if (exponent < -86)
+        {
+            return Fraction(0, 1);
+        }
+
+        using wide = __int128;
+        const wide n0 = mantissa;
+        const wide d0 = static_cast<wide>(1) << -exponent;
+        if (d0 <= max_denominator)
+        {
+            if (n0 > INT_MAX)
+            {
+                throw std::overflow_error("Value does not fit in a Fraction");
+            }
+            return Fraction(sign * static_cast<int>(n0), static_cast<int>(d0));
+        }
+
+        // Convergents p1/q1 (and the one before, p0/q0) of n0/d0
+        wide p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+        wide n = n0, d = d0;
+        while (d != 0)
+        {
+            wide a = n / d;
+            wide q2 = q0 + a * q1;
+            if (q2 > max_denominator)
+            {
+                break;
+            }
+            wide p2 = p0 + a * p1;
+            p0 = p1;
+            q0 = q1;
+            p1 = p2;
+            q1 = q2;
+            wide r = n - a * d;
+            n = d;
+            d = r;
+        }
+
+        // The best semiconvergent below the limit lies on the other side of
+        // x from p1/q1, and |p1 * qs - ps * q1| == 1, so p1/q1 is at least as
+        // close as ps/qs exactly when |x - p1/q1| <= 1 / (2 * q1 * qs)
+        wide k = (max_denominator - q0) / q1;
+        wide ps = p0 + k * p1;
+        wide qs = q0 + k * q1;
+        wide gap = n0 * q1 - p1 * d0;
+        if (gap < 0)
+        {
+            gap = -gap;
+        }
+        bool convergent = gap * 2 * qs <= d0;
+        wide p = convergent ? p1 : ps;
+        wide q = convergent ? q1 : qs;
+        if (p > INT_MAX)
+        {
+            throw std::overflow_error("Value does not fit in a Fraction");
+        }
+        return Fraction(sign * static_cast<int>(p), static_cast<int>(q));
+    }
+
+    double Fraction::to_double() const
+    {
+        // Both ints convert to double exactly and IEEE division rounds
+        // correctly, so this is the nearest double to the true quotient
+        return static_cast<double>(_numerator) / static_cast<double>(_denominator);
+    }
+
+    int Fraction::numerator() const
+    {
+        return _numerator;
+    }
+
+    int Fraction::denominator() const
+    {
+        return _denominator;
+    }
 }
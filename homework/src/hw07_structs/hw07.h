@@ -23,6 +23,22 @@ namespace cppclass
         bool operator==(const Fraction &other) const;
         bool operator!=(const Fraction &other) const;
 
+        // Returns the fraction closest to x whose denominator is at most
+        // max_denominator (ties go to the smaller denominator).
+        // Walks the continued fraction expansion of the exact binary value
+        // of x, so it takes O(log max_denominator) steps.
+        // Throws std::invalid_argument if x is NaN or infinite, or if
+        // max_denominator < 1.
+        // Throws std::overflow_error if the result does not fit in an int.
+        static Fraction from_double(double x, int max_denominator);
+
+        // Returns the double nearest to numerator / denominator
+        double to_double() const;
+
+        // Return the stored numerator and denominator
+        int numerator() const;
+        int denominator() const;
+
     private:
         int _numerator;
         int _denominator;
@@ -64,5 +80,6 @@ namespace cppclass
         FRIEND_TEST(HW07, lcm);
         FRIEND_TEST(HW07, constructor_basic);
         FRIEND_TEST(HW07, constructor_simplify);
+        FRIEND_TEST(HW07, from_double);
     };
 }
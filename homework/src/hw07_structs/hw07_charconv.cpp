@@ -0,0 +1,190 @@
+#include "hw07_charconv.h"
+
+#include <bit>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+namespace cppclass
+{
+    namespace
+    {
+        bool is_space(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        // Number of leading bytes of chunk (in memory order) that are '0'..'9'
+        int digit_prefix(uint64_t chunk)
+        {
+            // A byte's high bit is set if it is below '0' or above '9'
+            uint64_t low = chunk - 0x3030303030303030ULL;
+            uint64_t high = chunk + 0x4646464646464646ULL;
+            uint64_t bad = (low | high | chunk) & 0x8080808080808080ULL;
+            return bad == 0 ? 8 : std::countr_zero(bad) / 8;
+        }
+
+        // Value of the count (1..8) digits at the start of chunk
+        uint64_t digits_value(uint64_t chunk, int count)
+        {
+            // Keep the digits and move them up so the missing ones read as
+            // leading zeros, then combine pairs, quads and octets
+            chunk -= 0x3030303030303030ULL;
+            chunk <<= 8 * (8 - count);
+            chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFULL;
+            chunk = (chunk * (1 + (100ULL << 16)) >> 16) & 0x0000FFFF0000FFFFULL;
+            chunk = chunk * (1 + (10000ULL << 32)) >> 32;
+            return chunk;
+        }
+
+        // Parses an optionally negative int. Returns a from_chars_result in
+        // the same sense as std::from_chars.
+        std::from_chars_result parse_int(const char *first, const char *last, int &value)
+        {
+            const char *p = first;
+            bool negative = p != last && *p == '-';
+            p += negative ? 1 : 0;
+            const char *digits = p;
+            uint64_t magnitude = 0;
+            bool too_big = false;
+
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                while (last - p >= 8)
+                {
+                    uint64_t chunk;
+                    std::memcpy(&chunk, p, 8);
+                    int count = digit_prefix(chunk);
+                    if (count > 0)
+                    {
+                        uint64_t scale = 1;
+                        for (int i = 0; i < count; ++i)
+                        {
+                            scale *= 10;
+                        }
+                        too_big = too_big || magnitude > (UINT64_MAX - 99999999) / scale;
+                        magnitude = magnitude * scale + digits_value(chunk, count);
+                        p += count;
+                    }
+                    if (count < 8)
+                    {
+                        break;
+                    }
+                }
+            }
+            // Tail, or the whole number on big-endian targets
+            if (last - p < 8 || std::endian::native != std::endian::little)
+            {
+                for (; p != last && *p >= '0' && *p <= '9'; ++p)
+                {
+                    too_big = too_big || magnitude > UINT64_MAX / 10 - 1;
+                    magnitude = magnitude * 10 + static_cast<uint64_t>(*p - '0');
+                }
+            }
+
+            if (p == digits)
+            {
+                return {first, std::errc::invalid_argument};
+            }
+            uint64_t limit = negative ? static_cast<uint64_t>(INT_MAX) + 1 : INT_MAX;
+            if (too_big || magnitude > limit)
+            {
+                return {p, std::errc::result_out_of_range};
+            }
+            value = negative ? static_cast<int>(-static_cast<int64_t>(magnitude)) : static_cast<int>(magnitude);
+            return {p, std::errc()};
+        }
+    }
+
+    std::to_chars_result to_chars(char *first, char *last, const Fraction &f)
+    {
+        std::to_chars_result result = std::to_chars(first, last, f.numerator());
+        if (result.ec != std::errc())
+        {
+            return result;
+        }
+        if (result.ptr == last)
+        {
+            return {last, std::errc::value_too_large};
+        }
+        *result.ptr = '/';
+        return std::to_chars(result.ptr + 1, last, f.denominator());
+    }
+
+    std::from_chars_result from_chars(const char *first, const char *last, Fraction &f)
+    {
+        int numerator;
+        std::from_chars_result result = parse_int(first, last, numerator);
+        if (result.ec != std::errc())
+        {
+            return result;
+        }
+        int denominator = 1;
+        if (result.ptr != last && *result.ptr == '/')
+        {
+            result = parse_int(result.ptr + 1, last, denominator);
+            if (result.ec == std::errc::invalid_argument || (result.ec == std::errc() && denominator == 0))
+            {
+                return {first, std::errc::invalid_argument};
+            }
+            if (result.ec != std::errc())
+            {
+                return result;
+            }
+        }
+        f = Fraction(numerator, denominator);
+        return result;
+    }
+
+    std::to_chars_result to_chars(char *first, char *last, const Fraction *values, size_t count,
+                                  char separator)
+    {
+        char *p = first;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                if (p == last)
+                {
+                    return {last, std::errc::value_too_large};
+                }
+                *p++ = separator;
+            }
+            std::to_chars_result result = to_chars(p, last, values[i]);
+            if (result.ec != std::errc())
+            {
+                return result;
+            }
+            p = result.ptr;
+        }
+        return {p, std::errc()};
+    }
+
+    std::from_chars_result from_chars(const char *first, const char *last, std::vector<Fraction> &out)
+    {
+        const char *p = first;
+        Fraction value(0, 1);
+        while (true)
+        {
+            while (p != last && is_space(*p))
+            {
+                ++p;
+            }
+            if (p == last)
+            {
+                return {last, std::errc()};
+            }
+            std::from_chars_result result = from_chars(p, last, value);
+            if (result.ec != std::errc())
+            {
+                return result;
+            }
+            if (result.ptr != last && !is_space(*result.ptr))
+            {
+                return {p, std::errc::invalid_argument};
+            }
+            out.push_back(value);
+            p = result.ptr;
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "hw07.h"
+
+#include <charconv>
+#include <cstddef>
+#include <vector>
+
+namespace cppclass
+{
+    // Longest text to_chars can write for one Fraction: "-2147483648/-2147483648"
+    constexpr size_t fraction_max_chars = 23;
+
+    // Writes f as "numerator/denominator" into [first, last), like
+    // std::to_chars: no locale, no allocation, no terminating '\0'.
+    // Returns {end of the text, errc()} or, if the text does not fit,
+    // {last, std::errc::value_too_large}.
+    std::to_chars_result to_chars(char *first, char *last, const Fraction &f);
+
+    // Parses "n/d" or "n" (denominator 1) from [first, last), like
+    // std::from_chars: no leading whitespace or '+', an optional '-' before
+    // either number. Digits are read eight at a time.
+    // Returns {one past the text, errc()} and assigns f on success.
+    // Returns {first, std::errc::invalid_argument} if there is no number,
+    // a '/' is not followed by one, or the denominator is 0, and {end of the digits,
+    // std::errc::result_out_of_range} if a number does not fit in an int.
+    // f is left unchanged on failure.
+    std::from_chars_result from_chars(const char *first, const char *last, Fraction &f);
+
+    // Writes count fractions separated by separator, with no trailing
+    // separator. fraction_max_chars + 1 bytes per value always suffice.
+    // Returns {last, std::errc::value_too_large} if the text does not fit.
+    std::to_chars_result to_chars(char *first, char *last, const Fraction *values, size_t count,
+                                  char separator = ' ');
+
+    // Parses fractions separated by runs of spaces, tabs or newlines and
+    // appends them to out. Stops at the first malformed token and returns
+    // its error, keeping everything parsed before it; otherwise returns
+    // {last, errc()}.
+    std::from_chars_result from_chars(const char *first, const char *last, std::vector<Fraction> &out);
+}
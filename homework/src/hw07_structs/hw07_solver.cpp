@@ -0,0 +1,228 @@
+#include "hw07_solver.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace cppclass
+{
+    namespace
+    {
+        using wide = __int128;
+
+        // Sets out to a * b - c * d; returns false if any step overflows Int
+        template <typename Int>
+        bool cross(Int a, Int b, Int c, Int d, Int &out)
+        {
+            Int ab;
+            Int cd;
+            return !__builtin_mul_overflow(a, b, &ab)
+                && !__builtin_mul_overflow(c, d, &cd)
+                && !__builtin_sub_overflow(ab, cd, &out);
+        }
+
+        wide gcd(wide a, wide b)
+        {
+            while (b != 0)
+            {
+                wide r = a % b;
+                a = b;
+                b = r;
+            }
+            return a;
+        }
+
+        // Fraction-free Gauss-Jordan elimination of the n x (n + 1) row-major
+        // matrix m. After step k every entry is a (k + 1) x (k + 1) minor, so
+        // the division by the previous pivot is exact. On success every
+        // diagonal entry equals pivot (the determinant, up to sign) and
+        // m[i][n] / pivot is the i-th unknown.
+        template <typename Int>
+        SolveStatus eliminate(std::vector<Int> &m, size_t n, Int &pivot)
+        {
+            size_t width = n + 1;
+            Int previous = 1;
+            for (size_t k = 0; k < n; ++k)
+            {
+                size_t r = k;
+                while (r < n && m[r * width + k] == 0)
+                {
+                    ++r;
+                }
+                if (r == n)
+                {
+                    return SolveStatus::Singular;
+                }
+                if (r != k)
+                {
+                    std::swap_ranges(m.begin() + r * width, m.begin() + (r + 1) * width, m.begin() + k * width);
+                }
+
+                Int p = m[k * width + k];
+                for (size_t i = 0; i < n; ++i)
+                {
+                    if (i == k)
+                    {
+                        continue;
+                    }
+                    Int factor = m[i * width + k];
+                    for (size_t j = k + 1; j < width; ++j)
+                    {
+                        Int value;
+                        // The minimum divided by a pivot of -1 overflows too
+                        if (!cross(p, m[i * width + j], factor, m[k * width + j], value)
+                            || (previous == -1 && value == std::numeric_limits<Int>::min()))
+                        {
+                            return SolveStatus::Overflow;
+                        }
+                        m[i * width + j] = value / previous;
+                    }
+                    m[i * width + k] = 0;
+                    if (i < k)
+                    {
+                        // Earlier rows only held the previous pivot on their diagonal
+                        m[i * width + i] = p;
+                    }
+                }
+                previous = p;
+            }
+            pivot = previous;
+            return SolveStatus::Ok;
+        }
+
+        template <typename Int>
+        SolveStatus solve_with(const std::vector<wide> &augmented, size_t n, std::vector<Fraction> &x)
+        {
+            std::vector<Int> m(augmented.begin(), augmented.end());
+            Int pivot;
+            SolveStatus status = eliminate(m, n, pivot);
+            if (status != SolveStatus::Ok)
+            {
+                return status;
+            }
+
+            wide den = pivot;
+            if (den == std::numeric_limits<wide>::min())
+            {
+                return SolveStatus::Overflow;
+            }
+            std::vector<Fraction> out;
+            out.reserve(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                wide num = m[i * (n + 1) + n];
+                wide d = den;
+                if (d < 0)
+                {
+                    num = -num;
+                    d = -d;
+                }
+                wide g = gcd(num < 0 ? -num : num, d);
+                num /= g;
+                d /= g;
+                if (num < -INT_MAX || num > INT_MAX || d > INT_MAX)
+                {
+                    return SolveStatus::Overflow;
+                }
+                out.emplace_back(static_cast<int>(num), static_cast<int>(d));
+            }
+            x.swap(out);
+            return SolveStatus::Ok;
+        }
+
+        // Tries 64-bit elimination when every input entry fits, then 128-bit.
+        SolveStatus solve_augmented(const std::vector<wide> &augmented, size_t n, std::vector<Fraction> &x)
+        {
+            bool narrow = true;
+            for (wide v : augmented)
+            {
+                if (v < LLONG_MIN || v > LLONG_MAX)
+                {
+                    narrow = false;
+                    break;
+                }
+            }
+            if (narrow)
+            {
+                SolveStatus status = solve_with<long long>(augmented, n, x);
+                if (status != SolveStatus::Overflow)
+                {
+                    return status;
+                }
+            }
+            return solve_with<wide>(augmented, n, x);
+        }
+
+        template <typename Row>
+        void check_shape(const std::vector<Row> &a, size_t b_size)
+        {
+            if (b_size != a.size())
+            {
+                throw std::invalid_argument("Right-hand side size does not match the matrix");
+            }
+            for (const Row &row : a)
+            {
+                if (row.size() != a.size())
+                {
+                    throw std::invalid_argument("Matrix is not square");
+                }
+            }
+        }
+    }
+
+    SolveStatus solve_exact(const std::vector<std::vector<long long>> &a,
+                            const std::vector<long long> &b,
+                            std::vector<Fraction> &x)
+    {
+        check_shape(a, b.size());
+        x.clear();
+        size_t n = a.size();
+        std::vector<wide> augmented;
+        augmented.reserve(n * (n + 1));
+        for (size_t i = 0; i < n; ++i)
+        {
+            augmented.insert(augmented.end(), a[i].begin(), a[i].end());
+            augmented.push_back(b[i]);
+        }
+        return solve_augmented(augmented, n, x);
+    }
+
+    SolveStatus solve_exact(const std::vector<std::vector<Fraction>> &a,
+                            const std::vector<Fraction> &b,
+                            std::vector<Fraction> &x)
+    {
+        check_shape(a, b.size());
+        x.clear();
+        size_t n = a.size();
+        std::vector<wide> augmented;
+        augmented.reserve(n * (n + 1));
+        for (size_t i = 0; i < n; ++i)
+        {
+            // Scale the row by the lcm of its denominators
+            wide scale = 1;
+            for (size_t j = 0; j <= n; ++j)
+            {
+                const Fraction &f = j < n ? a[i][j] : b[i];
+                wide d = f.denominator() < 0 ? -static_cast<wide>(f.denominator()) : f.denominator();
+                if (__builtin_mul_overflow(scale / gcd(scale, d), d, &scale))
+                {
+                    return SolveStatus::Overflow;
+                }
+            }
+            for (size_t j = 0; j <= n; ++j)
+            {
+                const Fraction &f = j < n ? a[i][j] : b[i];
+                wide value;
+                if (__builtin_mul_overflow(static_cast<wide>(f.numerator()), scale / f.denominator(), &value))
+                {
+                    return SolveStatus::Overflow;
+                }
+                augmented.push_back(value);
+            }
+        }
+        return solve_augmented(augmented, n, x);
+    }
+}
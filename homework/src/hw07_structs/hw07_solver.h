@@ -0,0 +1,36 @@
+#pragma once
+
+#include "hw07.h"
+
+#include <vector>
+
+namespace cppclass
+{
+    enum class SolveStatus
+    {
+        Ok,        // x holds the unique solution
+        Singular,  // the matrix has no inverse
+        Overflow   // an intermediate needed more than 128 bits, or an
+                   // answer does not fit in a Fraction
+    };
+
+    // Solves a * x = b exactly, where a is square and stored as a.size() rows.
+    // Uses fraction-free (Bareiss) Gauss-Jordan elimination: every
+    // intermediate is a minor of [a | b], so each division is exact and the
+    // entries grow only as fast as the determinant. The elimination runs in
+    // 64-bit integers and is redone in 128-bit integers if that overflows;
+    // Fractions are only built for the final answers.
+    // Pre-conditions: b.size() == a.size() and every row of a has a.size()
+    //   entries, otherwise throws std::invalid_argument
+    // Post-conditions: on SolveStatus::Ok, x holds the solution in lowest
+    //   terms with positive denominators; otherwise x is empty
+    SolveStatus solve_exact(const std::vector<std::vector<long long>> &a,
+                            const std::vector<long long> &b,
+                            std::vector<Fraction> &x);
+
+    // Same as above for Fraction coefficients; each row is first scaled by
+    // the lcm of its denominators so the elimination stays integral.
+    SolveStatus solve_exact(const std::vector<std::vector<Fraction>> &a,
+                            const std::vector<Fraction> &b,
+                            std::vector<Fraction> &x);
+}
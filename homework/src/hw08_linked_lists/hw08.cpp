@@ -1,5 +1,6 @@
 #include <cstddef>
 #include <cstdlib>
+#include <utility>
 
 #include "hw08.h"
 
@@ -33,10 +34,47 @@ LinkedList::LinkedList(const LinkedList &src) {
  *
  * @param src R-value reference to the linked list to move from.
  */
-LinkedList::LinkedList(LinkedList &&src) {
+LinkedList::LinkedList(LinkedList &&src) noexcept {
 
 }
 
+/**
+ * @brief Copy assignment. The copy is built before anything is released,
+ *        so if it throws this list is unchanged.
+ *
+ * @param src Reference to the linked list to copy from.
+ * @return Reference to this list.
+ */
+LinkedList& LinkedList::operator=(const LinkedList &src) {
+    LinkedList copy(src);
+    swap(copy);
+    return *this;
+}
+
+/**
+ * @brief Move assignment. Takes over the nodes of @p src and leaves it empty.
+ *
+ * @param src R-value reference to the linked list to move from.
+ * @return Reference to this list.
+ */
+LinkedList& LinkedList::operator=(LinkedList &&src) noexcept {
+    // The old nodes leave with the temporary and are freed by its destructor.
+    LinkedList moved(std::move(src));
+    swap(moved);
+    return *this;
+}
+
+/**
+ * @brief Exchanges the contents of two lists. No node is copied or freed.
+ *
+ * @param other Reference to the linked list to swap with.
+ */
+void LinkedList::swap(LinkedList &other) noexcept {
+    std::swap(m_head, other.m_head);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_size, other.m_size);
+}
+
 /**
  * @brief Destructor.
  */
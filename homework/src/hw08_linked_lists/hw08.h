@@ -39,7 +39,36 @@ public:
          *
          * @param src R-value reference to the linked list to move from.
          */
-        LinkedList(LinkedList &&src);
+        LinkedList(LinkedList &&src) noexcept;
+
+        /**
+         * @brief Copy assignment. The copy is built before anything is released,
+         *        so if it throws this list is unchanged.
+         *
+         * @param src Reference to the linked list to copy from.
+         * @return Reference to this list.
+         */
+        LinkedList& operator=(const LinkedList &src);
+
+        /**
+         * @brief Move assignment. Takes over the nodes of @p src and leaves it empty.
+         *
+         * @param src R-value reference to the linked list to move from.
+         * @return Reference to this list.
+         */
+        LinkedList& operator=(LinkedList &&src) noexcept;
+
+        /**
+         * @brief Exchanges the contents of two lists. No node is copied or freed.
+         *
+         * @param other Reference to the linked list to swap with.
+         */
+        void swap(LinkedList &other) noexcept;
+
+        /// @brief Found by ADL, so std::swap-using generic code picks it up.
+        friend void swap(LinkedList &a, LinkedList &b) noexcept {
+                a.swap(b);
+        }
 
         /**
          * @brief Destructor.
@@ -118,6 +147,7 @@ private:
         FRIEND_TEST(BasicLinkedListTest, GetSizeWithMutating);
         FRIEND_TEST(BasicLinkedListTest, HeadTailMutation);
         FRIEND_TEST(BasicLinkedListTest, MoveConstructor);
+        FRIEND_TEST(BasicLinkedListTest, Swap);
         FRIEND_TEST(LinkedListTest, Erase);
 };
 }
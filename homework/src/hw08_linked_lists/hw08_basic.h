@@ -0,0 +1,363 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+#include "policies.h"
+
+namespace cppclass {
+/**
+ * @brief Doubly linked list holding any element type, stored inside the nodes.
+ *
+ * Has the LinkedList interface, plus emplace_append()/emplace_insert() which
+ * build the element in place, so a list of records costs one allocation per
+ * element and no extra indirection. Elements are only copied by copying the
+ * list and only moved by move-assigning between lists whose allocators
+ * differ, so move-only types work. Nodes come from @p Alloc, rebound to Node;
+ * pmr::BasicLinkedList takes a std::pmr::memory_resource.
+ */
+template <typename T, typename Alloc = std::allocator<T>>
+class BasicLinkedList {
+public:
+        using value_type = T;
+        using allocator_type = Alloc;
+
+        /// @brief Node definition for the linked list.
+        struct Node {
+                T data;
+                Node *next;
+                Node *prev;
+
+                /// @brief Constructs the element from @p args.
+                template <typename... Args>
+                explicit Node(std::in_place_t, Args&&... args)
+                    : data(std::forward<Args>(args)...), next(nullptr), prev(nullptr) {}
+        };
+
+        /// @brief Constructs an empty linked list.
+        BasicLinkedList() : m_head(nullptr), m_tail(nullptr), m_size(0) {}
+
+        /// @brief Constructs an empty linked list whose nodes come from @p alloc.
+        explicit BasicLinkedList(const Alloc &alloc)
+            : m_head(nullptr), m_tail(nullptr), m_size(0), m_nodes(alloc) {}
+
+        /**
+         * @brief Constructs a linked list from an array.
+         *
+         * @param arr Pointer to the array.
+         * @param size Number of elements in the array.
+         */
+        BasicLinkedList(const T *arr, size_t size) : BasicLinkedList() {
+            for (size_t i = 0; i < size; ++i) {
+                emplace_append(nullptr, arr[i]);
+            }
+        }
+
+        /**
+         * @brief Copy constructor. Requires a copyable T.
+         *
+         * @param src Reference to the linked list to copy from.
+         */
+        BasicLinkedList(const BasicLinkedList &src)
+            : BasicLinkedList(src, src.m_nodes.select_on_copy()) {}
+
+        /// @brief Copy constructor whose nodes come from @p alloc.
+        BasicLinkedList(const BasicLinkedList &src, const Alloc &alloc)
+            : BasicLinkedList(src, NodeAllocator(alloc)) {}
+
+        /**
+         * @brief Move constructor. Takes over the nodes, and the allocator that
+         *        made them; no element is touched.
+         *
+         * @param src R-value reference to the linked list to move from.
+         */
+        BasicLinkedList(BasicLinkedList &&src) noexcept
+            : m_head(src.m_head), m_tail(src.m_tail), m_size(src.m_size), m_nodes(src.m_nodes) {
+            src.m_head = src.m_tail = nullptr;
+            src.m_size = 0;
+        }
+
+        /**
+         * @brief Copy assignment. The copy is built before anything is released,
+         *        so if it throws this list is unchanged. Requires a copyable T.
+         */
+        BasicLinkedList& operator=(const BasicLinkedList &src) {
+            if (this != &src) {
+                using propagate = typename NodeAllocator::propagate_on_copy;
+                BasicLinkedList copy(src, propagate::value ? src.m_nodes : m_nodes);
+                clear();
+                m_nodes.template propagate<propagate>(copy.m_nodes);
+                adopt(copy);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment. Takes over the nodes of @p src when this list's
+         *        allocator may free them; otherwise (e.g. two different pmr
+         *        resources) moves the elements into new nodes. @p src is left empty.
+         *        If moving an element throws, this list is left empty and @p src
+         *        keeps its nodes, some of them moved from.
+         */
+        BasicLinkedList& operator=(BasicLinkedList &&src) noexcept(NodeAllocator::adopts_on_move) {
+            if (this == &src) {
+                return *this;
+            }
+            clear();
+            if constexpr (!NodeAllocator::adopts_on_move) {
+                if (!(m_nodes == src.m_nodes)) {
+                    try {
+                        for (Node *p = src.m_head; p != nullptr; p = p->next) {
+                            emplace_append(nullptr, std::move(p->data));
+                        }
+                    } catch (...) {
+                        clear();
+                        throw;
+                    }
+                    src.clear();
+                    return *this;
+                }
+            }
+            m_nodes.template propagate<typename NodeAllocator::propagate_on_move>(src.m_nodes);
+            adopt(src);
+            return *this;
+        }
+
+        /**
+         * @brief Exchanges the contents of two lists. Allocators are swapped if they
+         *        propagate on swap; otherwise they must compare equal, as for std containers.
+         */
+        void swap(BasicLinkedList &other) noexcept {
+            std::swap(m_head, other.m_head);
+            std::swap(m_tail, other.m_tail);
+            std::swap(m_size, other.m_size);
+            m_nodes.swap(other.m_nodes);
+        }
+
+        friend void swap(BasicLinkedList &a, BasicLinkedList &b) noexcept {
+            a.swap(b);
+        }
+
+        /**
+         * @brief Destructor.
+         */
+        ~BasicLinkedList() {
+            clear();
+        }
+
+        /**
+         * @brief Remove an element from the linked list.
+         *
+         * @param node Pointer to a valid node in this list. If nullptr, does nothing.
+         */
+        void erase(Node *node) {
+            if (node == nullptr) {
+                return;
+            }
+            (node->prev != nullptr ? node->prev->next : m_head) = node->next;
+            (node->next != nullptr ? node->next->prev : m_tail) = node->prev;
+            m_nodes.destroy(node);
+            --m_size;
+        }
+
+        /**
+         * @brief Removes every element.
+         */
+        void clear() {
+            Node *p = m_head;
+            while (p != nullptr) {
+                Node *next = p->next;
+                m_nodes.destroy(p);
+                p = next;
+            }
+            m_head = m_tail = nullptr;
+            m_size = 0;
+        }
+
+        /**
+         * @brief Appends a copy of @p data after the specified node.
+         *
+         * @param data Data to store in the new node.
+         * @param node Pointer to a valid node in the list to append after. If nullptr, appends at end.
+         *
+         * @return Pointer to the newly created node.
+         */
+        Node* append(const T &data, Node *node = nullptr) {
+            return emplace_append(node, data);
+        }
+
+        /// @brief Appends @p data, moved into the new node, after the specified node.
+        Node* append(T &&data, Node *node = nullptr) {
+            return emplace_append(node, std::move(data));
+        }
+
+        /**
+         * @brief Inserts a copy of @p data before the specified node.
+         *
+         * @param data Data to store in the new node.
+         * @param node Pointer to a valid node in the list to insert before. If nullptr, inserts at the beginning.
+         * @return Pointer to the newly created node.
+         */
+        Node* insert(const T &data, Node *node = nullptr) {
+            return emplace_insert(node, data);
+        }
+
+        /// @brief Inserts @p data, moved into the new node, before the specified node.
+        Node* insert(T &&data, Node *node = nullptr) {
+            return emplace_insert(node, std::move(data));
+        }
+
+        /**
+         * @brief Constructs an element from @p args in a new node after the specified node.
+         *
+         * The node position comes first because @p args is variadic.
+         *
+         * @param node Pointer to a valid node in the list to append after. If nullptr, appends at end.
+         * @param args Arguments forwarded to T's constructor.
+         * @return Pointer to the newly created node. If T's constructor throws, the list is unchanged.
+         */
+        template <typename... Args>
+        Node* emplace_append(Node *node, Args&&... args) {
+            Node *created = m_nodes.create(std::in_place, std::forward<Args>(args)...);
+            if (node == nullptr) {
+                node = m_tail;
+            }
+            created->prev = node;
+            created->next = node != nullptr ? node->next : nullptr;
+            (created->next != nullptr ? created->next->prev : m_tail) = created;
+            (node != nullptr ? node->next : m_head) = created;
+            ++m_size;
+            return created;
+        }
+
+        /**
+         * @brief Constructs an element from @p args in a new node before the specified node.
+         *
+         * @param node Pointer to a valid node in the list to insert before. If nullptr, inserts at the beginning.
+         * @param args Arguments forwarded to T's constructor.
+         * @return Pointer to the newly created node. If T's constructor throws, the list is unchanged.
+         */
+        template <typename... Args>
+        Node* emplace_insert(Node *node, Args&&... args) {
+            Node *created = m_nodes.create(std::in_place, std::forward<Args>(args)...);
+            if (node == nullptr) {
+                node = m_head;
+            }
+            created->next = node;
+            created->prev = node != nullptr ? node->prev : nullptr;
+            (created->prev != nullptr ? created->prev->next : m_head) = created;
+            (node != nullptr ? node->prev : m_tail) = created;
+            ++m_size;
+            return created;
+        }
+
+        /**
+         * @brief Searches for the first node containing @p data.
+         *
+         * @param data Data to search for in the list.
+         * @return Pointer to the first node found with @p data. If not found, returns nullptr.
+         */
+        Node* search(const T &data) const {
+            for (Node *p = m_head; p != nullptr; p = p->next) {
+                if (p->data == data) {
+                    return p;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Accesses element at the given index.
+         *
+         * @param index Zero-based index of a node.
+         * @return Pointer to the node. If index is out of bounds, returns nullptr.
+         */
+        Node* at(unsigned int index) const {
+            if (index >= m_size) {
+                return nullptr;
+            }
+            Node *p = m_head;
+            for (; index > 0; --index) {
+                p = p->next;
+            }
+            return p;
+        }
+
+        /**
+         * @brief Returns number of nodes in the list.
+         *
+         * @return Current size of list.
+         */
+        size_t get_size() const {
+            return m_size;
+        }
+
+        /// @brief Returns a copy of the allocator the list was built with.
+        allocator_type get_allocator() const {
+            return allocator_type(m_nodes.get());
+        }
+
+        /**
+         * @brief Returns equality between two linked lists
+         *
+         * @return true if all elements in linked list are equal to each other in order and value
+         */
+        bool operator==(const BasicLinkedList &other) const {
+            if (m_size != other.m_size) {
+                return false;
+            }
+            for (const Node *a = m_head, *b = other.m_head; a != nullptr; a = a->next, b = b->next) {
+                if (!(a->data == b->data)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns non-equality between two linked lists
+         *
+         * @return false if all elements in linked list are equal to each other in order and value
+         */
+        bool operator!=(const BasicLinkedList &other) const {
+            return !(*this == other);
+        }
+
+private:
+        using NodeAllocator = policy::NodeAllocator<Node, Alloc>;
+
+        BasicLinkedList(const BasicLinkedList &src, const NodeAllocator &nodes)
+            : m_head(nullptr), m_tail(nullptr), m_size(0), m_nodes(nodes) {
+            try {
+                for (const Node *p = src.m_head; p != nullptr; p = p->next) {
+                    emplace_append(nullptr, p->data);
+                }
+            } catch (...) {
+                clear();
+                throw;
+            }
+        }
+
+        /// @brief Takes over the nodes of @p src. This list must be empty and able to free them.
+        void adopt(BasicLinkedList &src) noexcept {
+            m_head = src.m_head;
+            m_tail = src.m_tail;
+            m_size = src.m_size;
+            src.m_head = src.m_tail = nullptr;
+            src.m_size = 0;
+        }
+
+        Node *m_head; ///< Pointer to the first node.
+        Node *m_tail; ///< Pointer to the last node.
+        size_t m_size; ///< Number of elements in the list.
+        [[no_unique_address]] NodeAllocator m_nodes;
+};
+
+namespace pmr {
+/// @brief BasicLinkedList whose nodes come from a std::pmr::memory_resource, e.g. a NodePool or MonotonicArena.
+template <typename T>
+using BasicLinkedList = cppclass::BasicLinkedList<T, std::pmr::polymorphic_allocator<T>>;
+}
+}
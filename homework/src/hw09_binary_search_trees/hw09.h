@@ -1,11 +1,41 @@
 #pragma once
 
+#include <atomic>  // for std::atomic
 #include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+#include <iosfwd>  // for std::ostream
+#include <utility> // for std::swap, std::move
 
 namespace cppclass {
 
+namespace bst {
+template <typename Node>
+class Finger;
+
+/**
+* @brief Returns a version number never handed out before in this process, and never 0.
+*
+* A tree takes a new version whenever its nodes change, so a Finger that
+* recorded the old one can tell it is stale even when the root and size
+* happen to match again.
+*/
+inline uint64_t next_version()
+{
+    static std::atomic<uint64_t> last{0};
+    return last.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+} // namespace bst
+
+/**
+* @brief Test-only access to a tree's nodes, defined in tests/bst_harness.h.
+*/
+template <typename T>
+class BinarySearchTreeHarness;
+
 template <typename T>
 class BinarySearchTree {
+    friend class BinarySearchTreeHarness<T>;
+
 public:
     struct Node {
         T data;
@@ -15,6 +45,11 @@ public:
         Node(T val) : data(val), left(nullptr), right(nullptr) {}
     };
 
+    /**
+    * @brief Remembered insertion point for insert_hint().
+    */
+    using Finger = bst::Finger<Node>;
+
     /**
     * @brief An empty BinarySearchTree will be created.
     */
@@ -37,7 +72,30 @@ public:
     * @brief Move constructor for BinarySearchTree.
     * @param other R-value reference to another BinarySearchTree object.
     */
-    BinarySearchTree(BinarySearchTree&& other);
+    BinarySearchTree(BinarySearchTree&& other) noexcept;
+
+    /**
+    * @brief Copy assignment. Builds the copy first, so on exception *this is unchanged.
+    * @param other Reference to BinarySearchTree to copy from.
+    */
+    BinarySearchTree& operator=(const BinarySearchTree& other);
+
+    /**
+    * @brief Move assignment. Takes over the nodes of @p other and leaves it empty.
+    * @param other R-value reference to another BinarySearchTree object.
+    */
+    BinarySearchTree& operator=(BinarySearchTree&& other) noexcept;
+
+    /**
+    * @brief Exchanges the contents of two trees. No node is copied or freed.
+    * @param other The tree to swap with.
+    */
+    void swap(BinarySearchTree& other) noexcept;
+
+    friend void swap(BinarySearchTree& a, BinarySearchTree& b) noexcept
+    {
+        a.swap(b);
+    }
 
     /**
     * @brief Destructor for BinarySearchTree.
@@ -85,7 +143,138 @@ public:
     */
     bool operator!=(const BinarySearchTree& other) const;
 
+    /**
+    * @brief Builds the union of two trees, reusing their nodes instead of re-inserting.
+    *
+    * Like set_intersection() and set_difference(), this recurses once per
+    * tree level, so both trees should have the hashed-treap shape the
+    * join/split primitives keep (see bst::set_union). The union runs in
+    * O(m log(n/m + 1)) expected work for sizes m <= n; the intersection and
+    * difference also free the nodes they drop, one by one, which adds
+    * O(n + m) and O(rhs.size()) respectively. Passing the same tree
+    * as both operands is allowed: union and intersection return it as it
+    * is, and difference frees every node.
+    *
+    * @param lhs First tree. Left empty; its nodes move into the result.
+    * @param rhs Second tree. Left empty; its nodes move into the result or are freed.
+    * @return A tree holding every value found in either input.
+    */
+    static BinarySearchTree set_union(BinarySearchTree&& lhs, BinarySearchTree&& rhs);
+
+    /**
+    * @brief Builds the intersection of two trees, reusing their nodes.
+    *
+    * Takes O(m log(n/m + 1) + n + m) expected work: the nodes not kept are freed.
+    *
+    * @param lhs First tree. Left empty.
+    * @param rhs Second tree. Left empty.
+    * @return A tree holding every value found in both inputs.
+    */
+    static BinarySearchTree set_intersection(BinarySearchTree&& lhs, BinarySearchTree&& rhs);
+
+    /**
+    * @brief Builds the difference of two trees, reusing their nodes.
+    *
+    * Takes O(m log(n/m + 1) + rhs.size()) expected work: every node of @p rhs is freed.
+    *
+    * @param lhs Tree to subtract from. Left empty.
+    * @param rhs Tree of values to remove. Left empty.
+    * @return A tree holding every value of @p lhs that is not in @p rhs.
+    */
+    static BinarySearchTree set_difference(BinarySearchTree&& lhs, BinarySearchTree&& rhs);
+
+    /**
+    * @brief Checks the tree's invariants, splitting the work across threads.
+    * @param balanced Also require the heap order kept by the join/split primitives.
+    * @return True if the values are in BST order and m_size matches the node count.
+    */
+    bool verify(bool balanced = false) const;
+
+    /**
+    * @brief Writes the values in-order, space separated, through a buffered sink.
+    * @param out Stream to write to. It is written in large blocks, not per node.
+    */
+    void dump_in_order(std::ostream& out) const;
+
+    /**
+    * @brief Writes the values one tree level per line through a buffered sink.
+    * @param out Stream to write to.
+    */
+    void dump_level_order(std::ostream& out) const;
+
+    /**
+    * @brief Writes the sideways layout of example_05/bst.txt: root at the left, right subtree on top.
+    * @param out Stream to write to.
+    */
+    void dump_sideways(std::ostream& out) const;
+
+    /**
+    * @brief Visits every value in ascending order.
+    * @param visit Callable invoked as visit(const T&).
+    */
+    template <typename Visit>
+    void for_each(Visit&& visit) const;
+
+    /**
+    * @brief Removes every value matching @p pred in O(n) by filtering the sorted node list, then rebuilds the tree.
+    * @param pred Callable invoked as pred(const T&); true means remove. If it throws, the values
+    *             are unchanged; the tree is rebuilt as a hashed treap and fingers restart.
+    * @return The number of values removed.
+    */
+    template <typename Predicate>
+    size_t remove_if(Predicate pred);
+
+    /**
+    * @brief Removes every value listed in @p sorted_keys in one in-order pass, then rebuilds the tree.
+    * @param sorted_keys Values to remove, sorted ascending. Values not in the tree are skipped.
+    * @param count Number of entries in @p sorted_keys.
+    * @return The number of values removed.
+    */
+    size_t remove_batch(const T* sorted_keys, size_t count);
+
+    /**
+    * @brief Inserts a value, searching from the last hinted insertion point instead of the root.
+    *
+    * Keeps the hashed-treap shape of the join/split primitives. Reusing one
+    * @p hint across a sorted or nearly sorted stream makes each insert
+    * amortized O(1). The hint records the tree's version, size and root, and
+    * restarts from the root when they differ: after the other members built
+    * on the bst:: functions, on a different tree, or when insert() or remove()
+    * changed the size. A remove() and insert() that leave size and root as
+    * they were go unnoticed, so take a fresh finger after mixing them in.
+    *
+    * @param hint Finger left by the previous insert_hint(); a fresh one starts at the root.
+    * @param value The value to insert. Cannot be a duplicate.
+    * @return True if the value was inserted successfully, false if it already exists.
+    */
+    bool insert_hint(Finger& hint, T value);
+
 private:
+    /**
+    * @brief Adopts a subtree of @p size nodes as the whole tree.
+    */
+    BinarySearchTree(Node* root, size_t size) noexcept : m_root(root), m_size(size) {}
+
+    /**
+    * @brief Hands all nodes to a new tree and leaves *this empty.
+    */
+    BinarySearchTree take() noexcept
+    {
+        BinarySearchTree taken(m_root, m_size);
+        m_root = nullptr;
+        m_size = 0;
+        modified();
+        return taken;
+    }
+
+    /**
+    * @brief Gives the tree a new version after its nodes changed, so fingers notice.
+    */
+    void modified() noexcept
+    {
+        m_version = bst::next_version();
+    }
+
     /**
     * @brief Prints the binary search tree in-order.
     */
@@ -99,7 +288,34 @@ private:
 
     Node* m_root;
     size_t m_size;
+    uint64_t m_version = bst::next_version(); ///< Changes whenever the nodes do; see modified().
 };
 
+template <typename T>
+BinarySearchTree<T>& BinarySearchTree<T>::operator=(const BinarySearchTree& other)
+{
+    BinarySearchTree(other).swap(*this);
+    return *this;
+}
+
+template <typename T>
+BinarySearchTree<T>& BinarySearchTree<T>::operator=(BinarySearchTree&& other) noexcept
+{
+    // The old nodes leave with the temporary and are freed by its destructor.
+    BinarySearchTree(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename T>
+void BinarySearchTree<T>::swap(BinarySearchTree& other) noexcept
+{
+    std::swap(m_root, other.m_root);
+    std::swap(m_size, other.m_size);
+    // Versions are unique per process, so a finger taken on either tree notices the exchange.
+    std::swap(m_version, other.m_version);
+}
+
 } // namespace cppclass
 
+#include "hw09_members.h"
+
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+#include <utility> // for std::pair
+#include <vector>
+
+#include "hw09_join.h"
+
+namespace cppclass {
+namespace bst {
+
+/**
+* @brief Flattens a tree into a sorted list chained through Node::right.
+*
+* Uses right rotations only, so it needs O(1) extra memory and O(n) time.
+*
+* @return The smallest node; every node's left child is nullptr.
+*/
+template <typename Node>
+Node* to_list(Node* root)
+{
+    Node* head = nullptr;
+    Node** tail = &head;
+    while (root != nullptr) {
+        if (root->left != nullptr) {
+            Node* left = root->left;
+            root->left = left->right;
+            left->right = root;
+            root = left;
+        } else {
+            *tail = root;
+            tail = &root->right;
+            root = root->right;
+        }
+    }
+    return head;
+}
+
+/**
+* @brief Right spine of a treap under construction, with each node's priority.
+*/
+template <typename Node>
+using Spine = std::vector<std::pair<Node*, uint64_t>>;
+
+/**
+* @brief Counts the nodes of a list chained through Node::right.
+*/
+template <typename Node>
+size_t length(const Node* head)
+{
+    size_t count = 0;
+    for (; head != nullptr; head = head->right) {
+        ++count;
+    }
+    return count;
+}
+
+/**
+* @brief Builds a hashed treap from a sorted list chained through Node::right.
+*
+* This is the linear-time Cartesian tree construction: each node is pushed on
+* the right spine after popping the spine nodes of lower priority, which
+* become its left subtree. The result has the shape join/split would give.
+* The spine never holds more nodes than the list, so if @p spine already has
+* that capacity this cannot throw.
+*
+* @return The root.
+*/
+template <typename Node>
+Node* from_list(Node* head, Spine<Node>& spine)
+{
+    spine.clear();
+    while (head != nullptr) {
+        Node* node = head;
+        head = head->right;
+        uint64_t p = priority(node->data);
+        Node* last = nullptr;
+        while (!spine.empty() && spine.back().second < p) {
+            last = spine.back().first;
+            spine.pop_back();
+        }
+        node->left = last;
+        node->right = nullptr;
+        if (!spine.empty()) {
+            spine.back().first->right = node;
+        }
+        spine.push_back({node, p});
+    }
+    return spine.empty() ? nullptr : spine.front().first;
+}
+
+template <typename Node>
+Node* from_list(Node* head)
+{
+    Spine<Node> spine;
+    return from_list(head, spine);
+}
+
+/**
+* @brief Rebuilds any tree, however degenerate, as a hashed treap in O(n).
+* @return The new root.
+*/
+template <typename Node>
+Node* rebalance(Node* root)
+{
+    return from_list(to_list(root));
+}
+
+/**
+* @brief Deletes every node whose value satisfies @p pred.
+*
+* The tree is flattened, filtered and rebuilt in O(n) regardless of how many
+* nodes go, instead of O(k log n) for k separate removals. All memory the
+* rebuild needs is reserved before @p pred runs, and @p pred is asked about
+* every node before anything is unlinked, so if it throws no node is lost and
+* the exception propagates: the values are unchanged; the tree is rebuilt as
+* a hashed treap. Should the reservation itself fail, the nodes are left as
+* a sorted chain, still a valid search tree. The unlinked nodes are deleted
+* only once the tree is whole again.
+*
+* @return The number of nodes deleted.
+*/
+template <typename Node, typename Predicate>
+size_t remove_if(Node*& root, Predicate pred)
+{
+    Node* head = to_list(root);
+    size_t count = length(head);
+    Spine<Node> spine;
+    std::vector<bool> doomed;
+    try {
+        spine.reserve(count);
+        doomed.reserve(count);
+    } catch (...) {
+        root = head;
+        throw;
+    }
+    try {
+        for (Node* node = head; node != nullptr; node = node->right) {
+            doomed.push_back(static_cast<bool>(pred(node->data)));
+        }
+    } catch (...) {
+        root = from_list(head, spine);
+        throw;
+    }
+
+    size_t removed = 0;
+    Node* unlinked = nullptr;
+    Node** link = &head;
+    for (bool remove : doomed) {
+        Node* node = *link;
+        if (remove) {
+            *link = node->right;
+            node->right = unlinked;
+            unlinked = node;
+            ++removed;
+        } else {
+            link = &node->right;
+        }
+    }
+    root = from_list(head, spine);
+    while (unlinked != nullptr) {
+        Node* next = unlinked->right;
+        delete unlinked;
+        unlinked = next;
+    }
+    return removed;
+}
+
+/**
+* @brief Deletes every node whose value appears in @p keys, in one pass.
+*
+* As in remove_if(), the rebuild's memory is reserved before any node is
+* unlinked and the unlinked nodes are deleted only once the tree is whole
+* again; should the reservation fail, nothing is removed and the nodes are
+* left as a sorted chain.
+*
+* @param keys Values to remove, sorted ascending. Absent values are skipped.
+* @param count Number of entries in @p keys.
+* @return The number of nodes deleted.
+*/
+template <typename Node, typename T>
+size_t remove_batch(Node*& root, const T* keys, size_t count)
+{
+    Node* head = to_list(root);
+    Spine<Node> spine;
+    try {
+        spine.reserve(length(head));
+    } catch (...) {
+        root = head;
+        throw;
+    }
+
+    size_t removed = 0;
+    size_t k = 0;
+    Node* unlinked = nullptr;
+    Node** link = &head;
+    while (*link != nullptr && k < count) {
+        Node* node = *link;
+        if (keys[k] < node->data) {
+            ++k;
+        } else if (node->data < keys[k]) {
+            link = &node->right;
+        } else {
+            *link = node->right;
+            node->right = unlinked;
+            unlinked = node;
+            ++removed;
+            ++k;
+        }
+    }
+    root = from_list(head, spine);
+    while (unlinked != nullptr) {
+        Node* next = unlinked->right;
+        delete unlinked;
+        unlinked = next;
+    }
+    return removed;
+}
+
+} // namespace bst
+} // namespace cppclass
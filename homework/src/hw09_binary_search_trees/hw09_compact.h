@@ -0,0 +1,408 @@
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>  // for std::move
+#include <vector>
+
+#include "hw09_join.h"
+
+namespace cppclass {
+
+/**
+* @brief BinarySearchTree that keeps its nodes in one vector with 32-bit child indices.
+*
+* A node is sizeof(T) plus two uint32_t (12 bytes for int, against 24 bytes
+* plus allocator overhead for BinarySearchTree<int>::Node). Because links are
+* indices rather than pointers, the node array can be moved, copied or
+* written to disk as raw bytes. Slots freed by remove() are chained into a
+* free list and reused by later inserts; a freed slot's value is reset to
+* T() when T is default-constructible, and otherwise kept until reuse.
+*
+* The tree is kept as a hashed treap, like the bst:: join/split functions:
+* bst::priority(value) is a pure function of the value, so nodes need no
+* balance field and any insertion order, sorted included, gives expected
+* O(log n) depth.
+*
+* The tree holds at most 2^32 - 1 nodes.
+*/
+template <typename T>
+class CompactBinarySearchTree {
+public:
+    using Index = uint32_t;
+    static constexpr Index npos = ~Index(0);
+
+    struct Node {
+        T data;
+        Index left;
+        Index right;
+    };
+
+    /**
+    * @brief An empty CompactBinarySearchTree will be created.
+    */
+    CompactBinarySearchTree() : m_root(npos), m_free(npos), m_size(0) {}
+
+    /**
+    * @brief Constructor that initializes the tree with an array of values.
+    * @param arr Pointer to an array of values.
+    * @param size Size of the array.
+    */
+    CompactBinarySearchTree(const T* arr, int size) : CompactBinarySearchTree()
+    {
+        m_nodes.reserve(size > 0 ? size : 0);
+        for (int i = 0; i < size; ++i) {
+            insert(arr[i]);
+        }
+    }
+
+    /**
+    * @brief Reserves room for @p count nodes so inserts do not reallocate.
+    */
+    void reserve(size_t count)
+    {
+        m_nodes.reserve(count);
+    }
+
+    /**
+    * @brief Inserts a value into the tree.
+    *
+    * Top-down treap insertion: descend until a node of lower priority, then
+    * split that subtree around the value into the new node's children.
+    *
+    * @param value The value to insert. Cannot be a duplicate.
+    * @return True if the value was inserted successfully, false if it already exists.
+    */
+    bool insert(T value)
+    {
+        uint64_t p = bst::priority(value);
+        // Link by parent index: allocate() may grow m_nodes and move every node.
+        Index parent = npos;
+        bool go_left = false;
+        Index at = m_root;
+        while (at != npos && !(bst::priority(m_nodes[at].data) < p)) {
+            const Node& node = m_nodes[at];
+            if (value < node.data) {
+                go_left = true;
+            } else if (node.data < value) {
+                go_left = false;
+            } else {
+                // An equal value has an equal priority, so it is always found above the split point.
+                return false;
+            }
+            parent = at;
+            at = go_left ? node.left : node.right;
+        }
+        // A tree read by deserialize() need only be in BST order, so the value may still lie below.
+        if (contains_below(at, value)) {
+            return false;
+        }
+
+        Index slot = allocate(value);
+        Index* left = &m_nodes[slot].left;
+        Index* right = &m_nodes[slot].right;
+        while (at != npos) {
+            if (value < m_nodes[at].data) {
+                *right = at;
+                right = &m_nodes[at].left;
+                at = *right;
+            } else {
+                *left = at;
+                left = &m_nodes[at].right;
+                at = *left;
+            }
+        }
+        *left = *right = npos;
+
+        if (parent == npos) {
+            m_root = slot;
+        } else if (go_left) {
+            m_nodes[parent].left = slot;
+        } else {
+            m_nodes[parent].right = slot;
+        }
+        ++m_size;
+        return true;
+    }
+
+    /**
+    * @brief Removes a value from the tree, putting its slot on the free list.
+    *
+    * The node's two subtrees are merged in priority order in its place.
+    *
+    * @param value The value to remove.
+    * @return True if the value was removed successfully, false if it was not found.
+    */
+    bool remove(T value)
+    {
+        Index* link = &m_root;
+        while (*link != npos) {
+            Node& node = m_nodes[*link];
+            if (value < node.data) {
+                link = &node.left;
+            } else if (node.data < value) {
+                link = &node.right;
+            } else {
+                break;
+            }
+        }
+        if (*link == npos) {
+            return false;
+        }
+
+        Index target = *link;
+        Index a = m_nodes[target].left;
+        Index b = m_nodes[target].right;
+        while (a != npos && b != npos) {
+            if (bst::priority(m_nodes[b].data) < bst::priority(m_nodes[a].data)) {
+                *link = a;
+                link = &m_nodes[a].right;
+                a = *link;
+            } else {
+                *link = b;
+                link = &m_nodes[b].left;
+                b = *link;
+            }
+        }
+        *link = a != npos ? a : b;
+        release(target);
+        --m_size;
+        return true;
+    }
+
+    /**
+    * @brief Checks if a value is contained in the tree.
+    * @param value The value to check.
+    * @return True if the value is found, false otherwise.
+    */
+    bool contains(T value) const
+    {
+        return contains_below(m_root, value);
+    }
+
+    /**
+    * @brief Returns the size of the tree.
+    * @return The number of values in the tree.
+    */
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+    * @brief Visits every value in ascending order.
+    * @param visit Callable invoked as visit(const T&).
+    */
+    template <typename Visit>
+    void for_each(Visit&& visit) const
+    {
+        std::vector<Index> stack;
+        Index at = m_root;
+        while (at != npos || !stack.empty()) {
+            for (; at != npos; at = m_nodes[at].left) {
+                stack.push_back(at);
+            }
+            at = stack.back();
+            stack.pop_back();
+            visit(m_nodes[at].data);
+            at = m_nodes[at].right;
+        }
+    }
+
+    /**
+    * @brief Checks if two trees hold the same values, regardless of shape.
+    * @param other The other tree to compare with.
+    * @return True if the trees are equal, false otherwise.
+    */
+    bool operator==(const CompactBinarySearchTree& other) const
+    {
+        if (m_size != other.m_size) {
+            return false;
+        }
+        bool same = true;
+        for_each([&](const T& value) { same = same && other.contains(value); });
+        return same;
+    }
+
+    /**
+    * @brief Checks if the tree is not equal to another tree.
+    * @param other The other tree to compare with.
+    * @return True if the trees are not equal, false otherwise.
+    */
+    bool operator!=(const CompactBinarySearchTree& other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+    * @brief Writes the tree, free list included, as raw bytes.
+    * @param out Binary stream to write to.
+    * @return True if every byte was written.
+    */
+    bool serialize(std::ostream& out) const
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "serialize() needs a trivially copyable T");
+        uint64_t header[4] = {m_nodes.size(), m_size, m_root, m_free};
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(m_nodes.data()),
+                  static_cast<std::streamsize>(m_nodes.size() * sizeof(Node)));
+        return out.good();
+    }
+
+    /**
+    * @brief Reads a tree written by serialize().
+    *
+    * Nodes are read in chunks, so a header claiming more nodes than the
+    * stream holds fails at end of stream instead of allocating them all up
+    * front. Every index is then checked: the tree must be in order, and the
+    * nodes reachable from the root plus those on the free list must be
+    * exactly the node array, each once.
+    *
+    * @param in Binary stream to read from.
+    * @return The tree.
+    * @throws std::runtime_error if the stream is truncated or malformed.
+    */
+    static CompactBinarySearchTree deserialize(std::istream& in)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "deserialize() needs a trivially copyable T");
+        uint64_t header[4];
+        if (!in.read(reinterpret_cast<char*>(header), sizeof(header))
+            || header[0] >= npos || header[1] > header[0]) {
+            throw std::runtime_error("Malformed CompactBinarySearchTree header");
+        }
+        CompactBinarySearchTree tree;
+        constexpr size_t chunk = size_t{1} << 16;
+        while (tree.m_nodes.size() < header[0]) {
+            size_t at = tree.m_nodes.size();
+            size_t count = header[0] - at < chunk ? header[0] - at : chunk;
+            tree.m_nodes.resize(at + count);
+            if (!in.read(reinterpret_cast<char*>(tree.m_nodes.data() + at),
+                         static_cast<std::streamsize>(count * sizeof(Node)))) {
+                throw std::runtime_error("Truncated CompactBinarySearchTree data");
+            }
+        }
+        tree.m_size = header[1];
+        tree.m_root = header[2] < header[0] ? static_cast<Index>(header[2]) : npos;
+        tree.m_free = header[3] < header[0] ? static_cast<Index>(header[3]) : npos;
+        if ((tree.m_root == npos && header[2] != npos) || (tree.m_free == npos && header[3] != npos)
+            || !tree.well_formed()) {
+            throw std::runtime_error("Malformed CompactBinarySearchTree data");
+        }
+        return tree;
+    }
+
+private:
+    /**
+    * @brief Searches the subtree rooted at @p at.
+    */
+    bool contains_below(Index at, const T& value) const
+    {
+        while (at != npos) {
+            const Node& node = m_nodes[at];
+            if (value < node.data) {
+                at = node.left;
+            } else if (node.data < value) {
+                at = node.right;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+    * @brief Checks the links of a node array from an untrusted source.
+    */
+    bool well_formed() const
+    {
+        size_t count = m_nodes.size();
+        std::vector<bool> seen(count, false);
+        auto claim = [&](Index at) {
+            if (at >= count || seen[at]) {
+                return false;
+            }
+            seen[at] = true;
+            return true;
+        };
+
+        struct Frame {
+            Index at;
+            const T* low;
+            const T* high;
+        };
+        std::vector<Frame> stack;
+        size_t reachable = 0;
+        if (m_root != npos) {
+            if (!claim(m_root)) {
+                return false;
+            }
+            stack.push_back({m_root, nullptr, nullptr});
+        }
+        while (!stack.empty()) {
+            Frame f = stack.back();
+            stack.pop_back();
+            const Node& node = m_nodes[f.at];
+            if ((f.low != nullptr && !(*f.low < node.data)) || (f.high != nullptr && !(node.data < *f.high))) {
+                return false;
+            }
+            ++reachable;
+            for (Index child : {node.left, node.right}) {
+                if (child != npos && !claim(child)) {
+                    return false;
+                }
+            }
+            if (node.left != npos) {
+                stack.push_back({node.left, f.low, &node.data});
+            }
+            if (node.right != npos) {
+                stack.push_back({node.right, &node.data, f.high});
+            }
+        }
+
+        size_t free = 0;
+        for (Index at = m_free; at != npos; at = m_nodes[at].left) {
+            if (!claim(at) || m_nodes[at].right != npos) {
+                return false;
+            }
+            ++free;
+        }
+        return reachable == m_size && reachable + free == count;
+    }
+
+    Index allocate(const T& value)
+    {
+        if (m_free != npos) {
+            Index slot = m_free;
+            m_free = m_nodes[slot].left;
+            m_nodes[slot] = Node{value, npos, npos};
+            return slot;
+        }
+        if (m_nodes.size() >= npos) {
+            throw std::length_error("CompactBinarySearchTree is full");
+        }
+        m_nodes.push_back(Node{value, npos, npos});
+        return static_cast<Index>(m_nodes.size() - 1);
+    }
+
+    void release(Index slot)
+    {
+        if constexpr (std::is_default_constructible_v<T>) {
+            // Drop the old value so it neither lingers in memory nor reaches serialize().
+            m_nodes[slot].data = T();
+        }
+        m_nodes[slot].left = m_free;
+        m_nodes[slot].right = npos;
+        m_free = slot;
+    }
+
+    std::vector<Node> m_nodes;
+    Index m_root;
+    Index m_free; ///< Head of the free list, chained through Node::left.
+    size_t m_size;
+};
+
+} // namespace cppclass
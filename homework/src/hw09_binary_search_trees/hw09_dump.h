@@ -0,0 +1,182 @@
+#pragma once
+
+#include <charconv>    // for std::to_chars
+#include <cstddef>     // for size_t
+#include <cstring>     // for memcpy
+#include <memory_resource>
+#include <ostream>
+#include <sstream>
+#include <string_view>
+#include <type_traits>
+#include <utility>     // for std::pair
+#include <vector>
+
+namespace cppclass {
+namespace bst {
+
+/**
+* @brief Buffered text sink that flushes to a std::ostream only when its buffer fills.
+*
+* Numbers are formatted with std::to_chars (no locale, no allocation);
+* other types go through operator<<. The buffer comes from @p resource, so a
+* request-scoped dump can take it from an arena instead of the heap.
+*/
+class Sink {
+public:
+    explicit Sink(std::ostream& out, size_t capacity = 1 << 16,
+                  std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    : m_out(out)
+    , m_buffer(capacity < 64 ? 64 : capacity, resource)
+    , m_used(0)
+    {}
+
+    Sink(const Sink&) = delete;
+
+    ~Sink()
+    {
+        flush();
+    }
+
+    void write(std::string_view text)
+    {
+        if (text.size() > m_buffer.size() - m_used) {
+            flush();
+            if (text.size() > m_buffer.size()) {
+                m_out.write(text.data(), static_cast<std::streamsize>(text.size()));
+                return;
+            }
+        }
+        std::memcpy(m_buffer.data() + m_used, text.data(), text.size());
+        m_used += text.size();
+    }
+
+    void put(char c)
+    {
+        if (m_used == m_buffer.size()) {
+            flush();
+        }
+        m_buffer[m_used++] = c;
+    }
+
+    void spaces(size_t count)
+    {
+        for (; count > 0; --count) {
+            put(' ');
+        }
+    }
+
+    template <typename T>
+    void value(const T& v)
+    {
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>) {
+            // 64 bytes covers the longest integer and shortest-round-trip double.
+            if (m_buffer.size() - m_used < 64) {
+                flush();
+            }
+            char* begin = m_buffer.data() + m_used;
+            auto result = std::to_chars(begin, m_buffer.data() + m_buffer.size(), v);
+            m_used += static_cast<size_t>(result.ptr - begin);
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            write(std::string_view(v));
+        } else {
+            std::ostringstream text;
+            text << v;
+            write(text.str());
+        }
+    }
+
+    void flush()
+    {
+        if (m_used > 0) {
+            m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+            m_used = 0;
+        }
+    }
+
+private:
+    std::ostream& m_out;
+    std::pmr::vector<char> m_buffer;
+    size_t m_used;
+};
+
+/**
+* @brief Writes the values in ascending order, space separated, ending with a newline.
+*/
+template <typename Node>
+void dump_in_order(const Node* root, Sink& sink)
+{
+    std::vector<const Node*> stack;
+    bool first = true;
+    while (root != nullptr || !stack.empty()) {
+        for (; root != nullptr; root = root->left) {
+            stack.push_back(root);
+        }
+        root = stack.back();
+        stack.pop_back();
+        if (!first) {
+            sink.put(' ');
+        }
+        first = false;
+        sink.value(root->data);
+        root = root->right;
+    }
+    sink.put('\n');
+}
+
+/**
+* @brief Writes one line per tree level, left to right.
+*/
+template <typename Node>
+void dump_level_order(const Node* root, Sink& sink)
+{
+    std::vector<const Node*> level;
+    std::vector<const Node*> next;
+    if (root != nullptr) {
+        level.push_back(root);
+    }
+    while (!level.empty()) {
+        for (size_t i = 0; i < level.size(); ++i) {
+            if (i > 0) {
+                sink.put(' ');
+            }
+            sink.value(level[i]->data);
+            if (level[i]->left != nullptr) {
+                next.push_back(level[i]->left);
+            }
+            if (level[i]->right != nullptr) {
+                next.push_back(level[i]->right);
+            }
+        }
+        sink.put('\n');
+        level.swap(next);
+        next.clear();
+    }
+}
+
+/**
+* @brief Writes the tree rotated a quarter turn: root on the left, right subtree on top.
+*
+* Each value is on its own line, indented @p indent spaces per level, as in
+* example_05/bst.txt. Walks the tree with an explicit stack.
+*/
+template <typename Node>
+void dump_sideways(const Node* root, Sink& sink, size_t indent = 4)
+{
+    std::vector<std::pair<const Node*, size_t>> stack;
+    size_t depth = 0;
+    while (root != nullptr || !stack.empty()) {
+        for (; root != nullptr; root = root->right, ++depth) {
+            stack.push_back({root, depth});
+        }
+        auto [node, node_depth] = stack.back();
+        stack.pop_back();
+        sink.spaces(node_depth * indent);
+        sink.value(node->data);
+        sink.put('\n');
+        root = node->left;
+        depth = node_depth + 1;
+    }
+}
+
+} // namespace bst
+} // namespace cppclass
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+#include <vector>
+
+#include "hw09_join.h"
+
+namespace cppclass {
+namespace bst {
+
+/**
+* @brief The root-to-node path of the last hinted insertion or lookup.
+*
+* Trees have no parent pointers, so the finger keeps the path itself, each
+* step with the nearest ancestors bounding its subtree. The next hinted
+* operation climbs only as far as the lowest subtree whose bounds contain its
+* value and descends from there, which for sorted or nearly sorted input is
+* a few steps instead of a full descent.
+*
+* A finger must not outlive changes to the tree made without it.
+* BinarySearchTree::insert_hint() records the tree's version number and size
+* with sync() and restarts from the root when either differs; seek() also
+* restarts when the root changed. The version covers every member built on
+* the bst:: functions. The size and root also catch a plain insert() or
+* remove(), but not a remove() and insert() that leave both as they were, so
+* take a fresh finger after those. Callers of the node-level functions,
+* which have no tree object, can pass a version of their own to sync() or
+* call reset() after changes.
+*/
+template <typename Node>
+class Finger {
+public:
+    /**
+    * @brief Forgets the path; the next hinted operation starts from the root.
+    */
+    void reset()
+    {
+        m_path.clear();
+    }
+
+    /**
+    * @brief Resets the finger unless it was last synced to @p version and @p size.
+    *
+    * Call with the tree's version and size before a hinted operation, and
+    * call advance() after changing the tree through the finger.
+    */
+    void sync(uint64_t version, size_t size)
+    {
+        if (version != m_version || size != m_size) {
+            m_path.clear();
+            m_version = version;
+            m_size = size;
+        }
+    }
+
+    /**
+    * @brief Records that the tree changed to @p version and @p size through this finger; the path stays valid.
+    */
+    void advance(uint64_t version, size_t size)
+    {
+        m_version = version;
+        m_size = size;
+    }
+
+    /**
+    * @brief The node the last hinted operation ended at, or nullptr.
+    */
+    Node* node() const
+    {
+        return m_path.empty() ? nullptr : m_path.back().node;
+    }
+
+    /**
+    * @brief Number of nodes the last hinted operation looked at.
+    */
+    size_t steps() const
+    {
+        return m_steps;
+    }
+
+    /**
+    * @brief Moves the finger to the node holding @p value, or to the node it would hang from.
+    * @return True if @p value is present; node() is then its node.
+    */
+    template <typename T>
+    bool seek(Node* root, const T& value)
+    {
+        m_steps = 0;
+        if (m_path.empty() || m_path.front().node != root) {
+            m_path.clear();
+            if (root == nullptr) {
+                return false;
+            }
+            m_path.push_back({root, nullptr, nullptr});
+        }
+        while (m_path.size() > 1 && !m_path.back().covers(value)) {
+            m_path.pop_back();
+            ++m_steps;
+        }
+        for (;;) {
+            Step at = m_path.back();
+            ++m_steps;
+            Node* next;
+            if (value < at.node->data) {
+                next = at.node->left;
+                if (next == nullptr) {
+                    return false;
+                }
+                m_path.push_back({next, at.low, at.node});
+            } else if (at.node->data < value) {
+                next = at.node->right;
+                if (next == nullptr) {
+                    return false;
+                }
+                m_path.push_back({next, at.node, at.high});
+            } else {
+                return true;
+            }
+        }
+    }
+
+    /**
+    * @brief Links a detached node below node() after a failed seek(), then rotates it up into treap order.
+    */
+    void link(Node*& root, Node* node)
+    {
+        node->left = node->right = nullptr;
+        // The path grows first: if that throws, the tree has not changed.
+        if (m_path.empty()) {
+            m_path.push_back({node, nullptr, nullptr});
+            root = node;
+            return;
+        }
+        Step parent = m_path.back();
+        if (node->data < parent.node->data) {
+            m_path.push_back({node, parent.low, parent.node});
+            parent.node->left = node;
+        } else {
+            m_path.push_back({node, parent.node, parent.high});
+            parent.node->right = node;
+        }
+
+        // Rotate up while the parent has the lower priority; the node takes over the parent's
+        // place and bounds on the path.
+        uint64_t p = priority(node->data);
+        while (m_path.size() > 1) {
+            Step& above = m_path[m_path.size() - 2];
+            if (!(priority(above.node->data) < p)) {
+                break;
+            }
+            Node* up = above.node;
+            if (up->left == node) {
+                up->left = node->right;
+                node->right = up;
+            } else {
+                up->right = node->left;
+                node->left = up;
+            }
+            above.node = node;
+            m_path.pop_back();
+            if (m_path.size() == 1) {
+                root = node;
+            } else {
+                Node* grand = m_path[m_path.size() - 2].node;
+                (grand->left == up ? grand->left : grand->right) = node;
+            }
+        }
+    }
+
+private:
+    struct Step {
+        Node* node;
+        const Node* low;  ///< Nearest ancestor the path went right from; bounds the subtree below.
+        const Node* high; ///< Nearest ancestor the path went left from; bounds the subtree above.
+
+        template <typename T>
+        bool covers(const T& value) const
+        {
+            return (low == nullptr || low->data < value) && (high == nullptr || value < high->data);
+        }
+    };
+
+    std::vector<Step> m_path;
+    size_t m_steps = 0;
+    uint64_t m_version = 0; ///< Version of the tree the path belongs to; 0 matches none.
+    size_t m_size = 0;      ///< Size of that tree when the path was last valid.
+};
+
+/**
+* @brief Inserts a detached node, starting the search from @p finger instead of the root.
+*
+* Keeps the hashed-treap shape, so the tree is the one bst::insert would
+* build. A sorted stream costs amortized O(1) per insert: the finger sits on
+* the largest value, and a new leaf rises an expected O(1) levels.
+*
+* @return True if the node was linked in, false if its value already existed.
+*         Either way @p finger is left on the node holding the value.
+*/
+template <typename Node>
+bool insert_hint(Node*& root, Finger<Node>& finger, Node* node)
+{
+    if (finger.seek(root, node->data)) {
+        return false;
+    }
+    finger.link(root, node);
+    return true;
+}
+
+/**
+* @brief Finds the node holding @p value, starting from @p finger instead of the root.
+* @return The node, or nullptr if the value is absent.
+*/
+template <typename Node, typename T>
+Node* find_hint(Node* root, Finger<Node>& finger, const T& value)
+{
+    return finger.seek(root, value) ? finger.node() : nullptr;
+}
+
+} // namespace bst
+} // namespace cppclass
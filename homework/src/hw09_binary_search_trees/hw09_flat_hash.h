@@ -0,0 +1,416 @@
+#pragma once
+
+#include <cstddef> // for size_t
+#include <cstdint> // for int8_t, uint32_t, uint64_t
+#include <cstring> // for memset
+#include <memory>  // for std::unique_ptr
+#include <new>     // for placement new
+#include <utility> // for std::move, std::swap
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "hw09_join.h"
+
+namespace cppclass {
+namespace flat {
+
+// Control byte of a slot: 0..127 holds the low 7 bits of a stored value's hash.
+constexpr int8_t empty = -128;
+constexpr int8_t deleted = -2;
+
+/**
+* @brief Sixteen control bytes, compared all at once.
+*
+* Each match returns a bitmask with bit i set when byte i matches.
+*/
+class Group {
+public:
+    static constexpr size_t width = 16;
+
+    explicit Group(const int8_t* ctrl) : m_ctrl(ctrl) {}
+
+    uint32_t match(int8_t h2) const
+    {
+#if defined(__SSE2__)
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_ctrl));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), bytes)));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < width; ++i) {
+            mask |= uint32_t{m_ctrl[i] == h2} << i;
+        }
+        return mask;
+#endif
+    }
+
+    uint32_t match_empty() const
+    {
+        return match(empty);
+    }
+
+    /**
+    * @brief Slots free for an insert: empty and deleted are the only negative control bytes.
+    */
+    uint32_t match_free() const
+    {
+#if defined(__SSE2__)
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m_ctrl))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < width; ++i) {
+            mask |= uint32_t{m_ctrl[i] < 0} << i;
+        }
+        return mask;
+#endif
+    }
+
+private:
+    const int8_t* m_ctrl;
+};
+
+} // namespace flat
+
+/**
+* @brief Unordered hash set with the BinarySearchTree interface: insert, remove, contains, size, ==.
+*
+* Open addressing in the Swiss table layout. Slots come in groups of 16 with
+* one control byte each; a control byte holds 7 bits of the value's hash, or
+* marks the slot empty or deleted. A lookup hashes once, picks a group with
+* the remaining bits, and compares all 16 control bytes in one SSE2
+* instruction, so it usually touches one cache line of control bytes and
+* one slot. Groups are probed triangularly until one has an empty slot.
+*
+* Values are stored inline, sizeof(T) plus one control byte per slot at most
+* 7/8 full (about 5 to 9 bytes per int, against 24 bytes plus allocator
+* overhead per BinarySearchTree<int>::Node). Iteration order is unspecified.
+* Hashes are bst::priority(value), so T needs std::hash and operator==.
+*/
+template <typename T>
+class FlatHashSet {
+public:
+    /**
+    * @brief An empty FlatHashSet will be created. Nothing is allocated until the first insert.
+    */
+    FlatHashSet() : m_capacity(0), m_size(0), m_growth_left(0) {}
+
+    /**
+    * @brief Constructor that initializes the set with an array of values.
+    * @param arr Pointer to an array of values.
+    * @param size Size of the array.
+    */
+    FlatHashSet(const T* arr, int size) : FlatHashSet()
+    {
+        reserve(size > 0 ? size : 0);
+        for (int i = 0; i < size; ++i) {
+            insert(arr[i]);
+        }
+    }
+
+    FlatHashSet(const FlatHashSet& other) : FlatHashSet()
+    {
+        reserve(other.m_size);
+        other.for_each([this](const T& value) { insert_new(value, bst::priority(value)); });
+    }
+
+    FlatHashSet(FlatHashSet&& other) noexcept : FlatHashSet()
+    {
+        swap(other);
+    }
+
+    /**
+    * @brief Copy-and-swap assignment: on exception *this is unchanged.
+    */
+    FlatHashSet& operator=(const FlatHashSet& other)
+    {
+        if (this != &other) {
+            FlatHashSet(other).swap(*this);
+        }
+        return *this;
+    }
+
+    FlatHashSet& operator=(FlatHashSet&& other) noexcept
+    {
+        FlatHashSet(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    void swap(FlatHashSet& other) noexcept
+    {
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growth_left, other.m_growth_left);
+    }
+
+    friend void swap(FlatHashSet& a, FlatHashSet& b) noexcept
+    {
+        a.swap(b);
+    }
+
+    ~FlatHashSet()
+    {
+        destroy_values();
+    }
+
+    /**
+    * @brief Makes room for @p count values without rehashing.
+    */
+    void reserve(size_t count)
+    {
+        if (count > m_size + m_growth_left) {
+            rehash(capacity_for(count));
+        }
+    }
+
+    /**
+    * @brief Inserts a value into the set.
+    * @param value The value to insert. Cannot be a duplicate.
+    * @return True if the value was inserted successfully, false if it already exists.
+    */
+    bool insert(T value)
+    {
+        uint64_t hash = bst::priority(value);
+        if (find(value, hash) != npos) {
+            return false;
+        }
+        insert_new(std::move(value), hash);
+        return true;
+    }
+
+    /**
+    * @brief Removes a value from the set, leaving a tombstone in its slot.
+    * @param value The value to remove.
+    * @return True if the value was removed successfully, false if it was not found.
+    */
+    bool remove(T value)
+    {
+        size_t slot = find(value, bst::priority(value));
+        if (slot == npos) {
+            return false;
+        }
+        m_slots[slot].value.~T();
+        m_ctrl[slot] = flat::deleted;
+        --m_size;
+        return true;
+    }
+
+    /**
+    * @brief Checks if a value is contained in the set.
+    * @param value The value to check.
+    * @return True if the value is found, false otherwise.
+    */
+    bool contains(T value) const
+    {
+        return find(value, bst::priority(value)) != npos;
+    }
+
+    /**
+    * @brief Returns the size of the set.
+    * @return The number of values in the set.
+    */
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+    * @brief Number of slots, a multiple of 16.
+    */
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+    * @brief Removes every value and frees the table.
+    */
+    void clear()
+    {
+        FlatHashSet().swap(*this);
+    }
+
+    /**
+    * @brief Visits every value once, in unspecified order.
+    * @param visit Callable invoked as visit(const T&).
+    */
+    template <typename Visit>
+    void for_each(Visit&& visit) const
+    {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (m_ctrl[i] >= 0) {
+                visit(m_slots[i].value);
+            }
+        }
+    }
+
+    /**
+    * @brief Checks if two sets hold the same values.
+    * @param other The other set to compare with.
+    * @return True if the sets are equal, false otherwise.
+    */
+    bool operator==(const FlatHashSet& other) const
+    {
+        if (m_size != other.m_size) {
+            return false;
+        }
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (m_ctrl[i] >= 0 && !other.contains(m_slots[i].value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+    * @brief Checks if the set is not equal to another set.
+    * @param other The other set to compare with.
+    * @return True if the sets are not equal, false otherwise.
+    */
+    bool operator!=(const FlatHashSet& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    static constexpr size_t npos = ~size_t(0);
+    static constexpr size_t width = flat::Group::width;
+
+    // Storage for one value, constructed only while its control byte is full.
+    union Slot {
+        Slot() {}
+        ~Slot() {}
+        T value;
+    };
+
+    static int8_t h2(uint64_t hash)
+    {
+        return static_cast<int8_t>(hash & 0x7f);
+    }
+
+    static size_t capacity_for(size_t count)
+    {
+        size_t capacity = width;
+        while (capacity - capacity / 8 < count) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    /**
+    * @brief Calls probe(first slot of group) over the probe sequence of @p hash until it returns true.
+    *
+    * Group g, g+1, g+3, g+6, ... visits every group once when the group count is a power of two.
+    */
+    template <typename Probe>
+    void for_each_group(uint64_t hash, Probe&& probe) const
+    {
+        size_t mask = m_capacity / width - 1;
+        size_t group = (hash >> 7) & mask;
+        for (size_t step = 1; !probe(group * width); ++step) {
+            group = (group + step) & mask;
+        }
+    }
+
+    size_t find(const T& value, uint64_t hash) const
+    {
+        if (m_size == 0) {
+            return npos;
+        }
+        size_t found = npos;
+        for_each_group(hash, [&](size_t base) {
+            flat::Group group(m_ctrl.get() + base);
+            for (uint32_t hits = group.match(h2(hash)); hits != 0; hits &= hits - 1) {
+                size_t slot = base + static_cast<size_t>(__builtin_ctz(hits));
+                if (m_slots[slot].value == value) {
+                    found = slot;
+                    return true;
+                }
+            }
+            return group.match_empty() != 0;
+        });
+        return found;
+    }
+
+    /**
+    * @brief Stores a value known to be absent.
+    */
+    void insert_new(T value, uint64_t hash)
+    {
+        size_t slot = free_slot(hash);
+        if (m_ctrl != nullptr && m_ctrl[slot] == flat::deleted) {
+            // Reusing a tombstone costs no growth.
+        } else if (m_growth_left == 0) {
+            // Full of values or tombstones: drop the tombstones, and double if that is not enough.
+            rehash(m_size + 1 > (m_capacity - m_capacity / 8) / 2 ? capacity_for(2 * m_size + 1) : m_capacity);
+            slot = free_slot(hash);
+            --m_growth_left;
+        } else {
+            --m_growth_left;
+        }
+        new (&m_slots[slot].value) T(std::move(value));
+        m_ctrl[slot] = h2(hash);
+        ++m_size;
+    }
+
+    size_t free_slot(uint64_t hash) const
+    {
+        if (m_capacity == 0) {
+            return npos;
+        }
+        size_t slot = npos;
+        for_each_group(hash, [&](size_t base) {
+            uint32_t free = flat::Group(m_ctrl.get() + base).match_free();
+            if (free == 0) {
+                return false;
+            }
+            slot = base + static_cast<size_t>(__builtin_ctz(free));
+            return true;
+        });
+        return slot;
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::unique_ptr<int8_t[]> ctrl(new int8_t[capacity]);
+        std::unique_ptr<Slot[]> slots(new Slot[capacity]);
+        std::memset(ctrl.get(), static_cast<unsigned char>(flat::empty), capacity);
+
+        std::swap(m_ctrl, ctrl);
+        std::swap(m_slots, slots);
+        size_t old_capacity = m_capacity;
+        m_capacity = capacity;
+        m_size = 0;
+        m_growth_left = capacity - capacity / 8;
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (ctrl[i] >= 0) {
+                uint64_t hash = bst::priority(slots[i].value);
+                size_t slot = free_slot(hash);
+                new (&m_slots[slot].value) T(std::move(slots[i].value));
+                m_ctrl[slot] = h2(hash);
+                slots[i].value.~T();
+                ++m_size;
+                --m_growth_left;
+            }
+        }
+    }
+
+    void destroy_values()
+    {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (m_ctrl[i] >= 0) {
+                m_slots[i].value.~T();
+            }
+        }
+    }
+
+    std::unique_ptr<int8_t[]> m_ctrl;
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_capacity;
+    size_t m_size;
+    size_t m_growth_left; ///< Empty slots that may still be filled before a rehash.
+};
+
+} // namespace cppclass
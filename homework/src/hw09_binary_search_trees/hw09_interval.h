@@ -0,0 +1,366 @@
+#pragma once
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+#include <memory>  // for std::unique_ptr
+#include <stdexcept>
+#include <utility> // for std::swap
+#include <vector>
+
+#include "hw09_join.h"
+
+namespace cppclass {
+
+/**
+* @brief Set of closed intervals [low, high] answering overlap queries.
+*
+* A priority search tree. The intervals sit in the leaves, ordered by
+* (low, high), and each internal node routes by a split key: the largest
+* interval of its left subtree. The internal nodes are balanced as a hashed
+* treap (see bst::priority), so the height is O(log n) in expectation.
+*
+* On top of that, every node has a slot naming one interval from a leaf
+* below it, and the slots form a max-heap on the high endpoint: a slot holds
+* the interval that ends last among those of its subtree not already held
+* above it. An overlap query with [a, b] skips every subtree whose slot ends
+* before a, and only descends right of a split key that starts no later
+* than b. Each node it looks at is either reported, a child of a reported
+* node, or on the search path for b, so a query reporting k intervals
+* costs O(log n + k). Updates cost O(log n) in expectation.
+*
+* An interval with high < low is rejected: insert() and overlapping() throw
+* std::invalid_argument, and remove() and contains() report it as absent.
+*/
+template <typename T>
+class IntervalTree {
+public:
+    struct Interval {
+        T low;
+        T high;
+
+        bool operator==(const Interval& other) const
+        {
+            return !(low < other.low) && !(other.low < low) && !(high < other.high) && !(other.high < high);
+        }
+    };
+
+    struct Node {
+        Interval key;       ///< The leaf's interval, or an internal node's split key.
+        uint64_t priority;  ///< Treap priority of an internal node, hashed from its split key.
+        const Node* slot;   ///< Leaf whose interval this node holds in the heap, or nullptr.
+        Node* left;         ///< Both children are nullptr exactly for a leaf.
+        Node* right;
+
+        Node(const Interval& val, Node* l = nullptr, Node* r = nullptr)
+        : key(val)
+        , priority(bst::priority(val.low) ^ (bst::priority(val.high) * 0x9e3779b97f4a7c15ULL))
+        , slot(nullptr)
+        , left(l)
+        , right(r)
+        {}
+    };
+
+    /**
+    * @brief An empty IntervalTree will be created.
+    */
+    IntervalTree() : m_root(nullptr), m_size(0) {}
+
+    IntervalTree(const IntervalTree&) = delete;
+
+    /**
+    * @brief Move constructor for IntervalTree.
+    * @param other R-value reference to another IntervalTree object.
+    */
+    IntervalTree(IntervalTree&& other) noexcept : m_root(other.m_root), m_size(other.m_size)
+    {
+        other.m_root = nullptr;
+        other.m_size = 0;
+    }
+
+    /**
+    * @brief Move assignment.
+    * @param other R-value reference to another IntervalTree object. Left empty.
+    */
+    IntervalTree& operator=(IntervalTree&& other) noexcept
+    {
+        IntervalTree(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    /**
+    * @brief Exchanges the contents of two trees.
+    */
+    void swap(IntervalTree& other) noexcept
+    {
+        std::swap(m_root, other.m_root);
+        std::swap(m_size, other.m_size);
+    }
+
+    friend void swap(IntervalTree& a, IntervalTree& b) noexcept
+    {
+        a.swap(b);
+    }
+
+    /**
+    * @brief Destructor for IntervalTree.
+    */
+    ~IntervalTree()
+    {
+        bst::destroy(m_root);
+    }
+
+    /**
+    * @brief Inserts the interval [low, high].
+    * @return True if the interval was inserted, false if it already exists.
+    * @throws std::invalid_argument if high < low.
+    */
+    bool insert(T low, T high)
+    {
+        check(low, high);
+        Interval key{low, high};
+        if (m_root == nullptr) {
+            m_root = new Node(key);
+            m_root->slot = m_root;
+            m_size = 1;
+            return true;
+        }
+
+        std::vector<Node**> path; // Links to the internal nodes above the leaf.
+        Node** link = &m_root;
+        while (!is_leaf(*link)) {
+            path.push_back(link);
+            link = goes_left(*link, key) ? &(*link)->left : &(*link)->right;
+        }
+        Node* leaf = *link;
+        if (leaf->key == key) {
+            return false;
+        }
+
+        // The new leaf and the branch above it are both allocated before anything is relinked.
+        std::unique_ptr<Node> added(new Node(key));
+        Node* branch = less(key, leaf->key) ? new Node(key, added.get(), leaf)
+                                            : new Node(leaf->key, leaf, added.get());
+        Node* fresh = added.release();
+        branch->slot = leaf->slot;
+        leaf->slot = nullptr;
+        *link = branch;
+
+        // Rotate the branch up into treap order, then let the new interval find its slot.
+        while (!path.empty() && (*path.back())->priority < branch->priority) {
+            lift(*path.back(), branch);
+            path.pop_back();
+        }
+        sift(m_root, fresh);
+        ++m_size;
+        return true;
+    }
+
+    /**
+    * @brief Removes the interval [low, high].
+    * @return True if the interval was removed, false if it was not found.
+    */
+    bool remove(T low, T high)
+    {
+        Interval key{low, high};
+        if (m_root == nullptr) {
+            return false;
+        }
+        Node** parent = nullptr;
+        Node** link = &m_root;
+        while (!is_leaf(*link)) {
+            parent = link;
+            link = goes_left(*link, key) ? &(*link)->left : &(*link)->right;
+        }
+        Node* leaf = *link;
+        if (!(leaf->key == key)) {
+            return false;
+        }
+
+        // The interval is held by a slot on its root path; free that slot first.
+        for (Node* at = m_root;; at = goes_left(at, key) ? at->left : at->right) {
+            if (at->slot == leaf) {
+                at->slot = nullptr;
+                pull_up(at);
+                break;
+            }
+        }
+        if (parent == nullptr) {
+            m_root = nullptr;
+        } else {
+            // Splice out the leaf's parent; the interval it held moves into the sibling.
+            Node* branch = *parent;
+            Node* sibling = branch->left == leaf ? branch->right : branch->left;
+            *parent = sibling;
+            if (branch->slot != nullptr) {
+                sift(sibling, branch->slot);
+            }
+            delete branch;
+        }
+        delete leaf;
+        --m_size;
+        return true;
+    }
+
+    /**
+    * @brief Checks if the interval [low, high] is in the tree.
+    */
+    bool contains(T low, T high) const
+    {
+        Interval key{low, high};
+        const Node* at = m_root;
+        if (at == nullptr) {
+            return false;
+        }
+        while (!is_leaf(at)) {
+            at = goes_left(at, key) ? at->left : at->right;
+        }
+        return at->key == key;
+    }
+
+    /**
+    * @brief Returns the number of intervals in the tree.
+    */
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+    * @brief Visits, in no particular order, every interval that overlaps [low, high].
+    * @param visit Callable invoked as visit(const Interval&).
+    * @return The number of nodes looked at, which is O(log n + k) for k intervals visited.
+    * @throws std::invalid_argument if high < low.
+    */
+    template <typename Visit>
+    size_t overlapping(T low, T high, Visit&& visit) const
+    {
+        check(low, high);
+        size_t examined = 0;
+        std::vector<const Node*> stack;
+        if (m_root != nullptr) {
+            stack.push_back(m_root);
+        }
+        while (!stack.empty()) {
+            const Node* at = stack.back();
+            stack.pop_back();
+            ++examined;
+            // Nothing below an empty slot, or below a slot ending before the query, can overlap it.
+            if (at->slot == nullptr || at->slot->key.high < low) {
+                continue;
+            }
+            if (!(high < at->slot->key.low)) {
+                visit(at->slot->key);
+            }
+            if (!is_leaf(at)) {
+                // Intervals right of the split start no earlier than the split key does.
+                if (!(high < at->key.low)) {
+                    stack.push_back(at->right);
+                }
+                stack.push_back(at->left);
+            }
+        }
+        return examined;
+    }
+
+    /**
+    * @brief Returns every interval that overlaps [low, high], in no particular order.
+    * @throws std::invalid_argument if high < low.
+    */
+    std::vector<Interval> overlapping(T low, T high) const
+    {
+        std::vector<Interval> hits;
+        overlapping(low, high, [&](const Interval& interval) { hits.push_back(interval); });
+        return hits;
+    }
+
+private:
+    static void check(const T& low, const T& high)
+    {
+        if (high < low) {
+            throw std::invalid_argument("Interval ends before it starts");
+        }
+    }
+
+    static bool less(const Interval& a, const Interval& b)
+    {
+        return a.low < b.low || (!(b.low < a.low) && a.high < b.high);
+    }
+
+    static bool is_leaf(const Node* node)
+    {
+        return node->left == nullptr;
+    }
+
+    // True if the leaf for key lies in the left subtree of the internal node.
+    static bool goes_left(const Node* node, const Interval& key)
+    {
+        return !less(node->key, key);
+    }
+
+    // True if a's slot ends later than b's; an empty slot ends earliest.
+    static bool ends_later(const Node* a, const Node* b)
+    {
+        return a->slot != nullptr && (b->slot == nullptr || b->slot->key.high < a->slot->key.high);
+    }
+
+    // Refills the empty slot of node from below, moving each hole down to a leaf.
+    static void pull_up(Node* node)
+    {
+        while (!is_leaf(node)) {
+            Node* from = ends_later(node->right, node->left) ? node->right : node->left;
+            if (from->slot == nullptr) {
+                return;
+            }
+            node->slot = from->slot;
+            from->slot = nullptr;
+            node = from;
+        }
+    }
+
+    // Places the interval of leaf point in the subtree of node, which holds that leaf.
+    static void sift(Node* node, const Node* point)
+    {
+        for (;;) {
+            if (node->slot == nullptr) {
+                node->slot = point;
+                return;
+            }
+            if (node->slot->key.high < point->key.high) {
+                std::swap(node->slot, point);
+            }
+            // A leaf's slot holds nothing but its own interval, so node is internal here.
+            node = goes_left(node, point->key) ? node->left : node->right;
+        }
+    }
+
+    // Rotates child above its parent, which link points to, and repairs both slots.
+    static void lift(Node*& link, Node* child)
+    {
+        Node* parent = link;
+        const Node* carried = child->slot;
+        bool carried_left = carried != nullptr && goes_left(child, carried->key);
+        Node* home;
+        if (parent->left == child) {
+            parent->left = child->right;
+            child->right = parent;
+            home = carried_left ? child->left : parent;
+        } else {
+            parent->right = child->left;
+            child->left = parent;
+            home = carried_left ? parent : child->right;
+        }
+        link = child;
+        // The top still covers the same leaves, so it keeps the top slot.
+        child->slot = parent->slot;
+        parent->slot = nullptr;
+        pull_up(parent);
+        if (carried != nullptr) {
+            sift(home, carried);
+        }
+    }
+
+    Node* m_root;
+    size_t m_size;
+};
+
+} // namespace cppclass
@@ -0,0 +1,403 @@
+#pragma once
+
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint64_t
+#include <functional> // for std::hash
+#include <utility>    // for std::pair
+#include <vector>
+
+#include "thread_pool.h"
+
+namespace cppclass {
+namespace bst {
+
+/**
+* @brief Heap priority of a key when a tree is kept as a hashed treap.
+*
+* The priority is a pure function of the key, so a tree built only through
+* join/split has the same (expected O(log n) height) shape no matter in which
+* order the keys arrived, and nodes need no extra balance field.
+*/
+template <typename T>
+uint64_t priority(const T& value)
+{
+    uint64_t x = static_cast<uint64_t>(std::hash<T>{}(value));
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+* @brief Recursion depth below which the set operations stop forking tasks.
+* @return A depth that yields a few tasks per worker of the shared pool, or 0 with one worker.
+*/
+inline unsigned default_fork_depth()
+{
+    unsigned threads = runtime::ThreadPool::global().size();
+    if (threads <= 1) {
+        return 0;
+    }
+    unsigned depth = 2;
+    while (threads > 1) {
+        threads >>= 1;
+        ++depth;
+    }
+    return depth;
+}
+
+/**
+* @brief Deletes every node of a subtree without recursing.
+* @param root The subtree to free. May be nullptr.
+* @return The number of nodes deleted.
+*/
+template <typename Node>
+size_t destroy(Node* root)
+{
+    size_t count = 0;
+    while (root != nullptr) {
+        if (root->left != nullptr) {
+            // Rotate right so the left spine shrinks until root has no left child.
+            Node* left = root->left;
+            root->left = left->right;
+            left->right = root;
+            root = left;
+        } else {
+            Node* right = root->right;
+            delete root;
+            root = right;
+            ++count;
+        }
+    }
+    return count;
+}
+
+/**
+* @brief Finds the node holding @p value.
+* @return The node, or nullptr if the value is absent.
+*/
+template <typename Node, typename T>
+Node* find(Node* root, const T& value)
+{
+    while (root != nullptr) {
+        if (value < root->data) {
+            root = root->left;
+        } else if (root->data < value) {
+            root = root->right;
+        } else {
+            return root;
+        }
+    }
+    return nullptr;
+}
+
+/**
+* @brief Calls visit(value) for every node in ascending order, without recursion.
+*/
+template <typename Node, typename Visit>
+void for_each(const Node* root, Visit& visit)
+{
+    std::vector<const Node*> stack;
+    while (root != nullptr || !stack.empty()) {
+        for (; root != nullptr; root = root->left) {
+            stack.push_back(root);
+        }
+        root = stack.back();
+        stack.pop_back();
+        visit(root->data);
+        root = root->right;
+    }
+}
+
+/**
+* @brief Joins two trees and a middle node into one tree.
+*
+* Walks down the right spine of @p left and the left spine of @p right
+* without recursing, so degenerate inputs cost time but not stack.
+*
+* @param left Tree whose values are all less than @p mid->data.
+* @param mid Detached node; its children are overwritten.
+* @param right Tree whose values are all greater than @p mid->data.
+* @return Root of the joined tree.
+*/
+template <typename Node>
+Node* join(Node* left, Node* mid, Node* right)
+{
+    uint64_t p = priority(mid->data);
+    Node* root;
+    Node** hook = &root;
+    for (;;) {
+        bool above_left = left == nullptr || priority(left->data) < p;
+        bool above_right = right == nullptr || priority(right->data) < p;
+        if (above_left && above_right) {
+            mid->left = left;
+            mid->right = right;
+            *hook = mid;
+            return root;
+        }
+        if (!above_left && (above_right || priority(right->data) < priority(left->data))) {
+            *hook = left;
+            hook = &left->right;
+            left = left->right;
+        } else {
+            *hook = right;
+            hook = &right->left;
+            right = right->left;
+        }
+    }
+}
+
+/**
+* @brief Joins two trees where every value of @p left is less than every value of @p right.
+* @return Root of the joined tree.
+*/
+template <typename Node>
+Node* join2(Node* left, Node* right)
+{
+    Node* root;
+    Node** hook = &root;
+    while (left != nullptr && right != nullptr) {
+        if (priority(right->data) < priority(left->data)) {
+            *hook = left;
+            hook = &left->right;
+            left = left->right;
+        } else {
+            *hook = right;
+            hook = &right->left;
+            right = right->left;
+        }
+    }
+    *hook = left != nullptr ? left : right;
+    return root;
+}
+
+/**
+* @brief Splits a tree around @p value.
+*
+* Cuts along the search path without recursing and without reordering
+* nodes, so any tree in BST order can be split, and heap order is kept.
+*
+* @param root The tree to split. Its nodes are redistributed into the outputs.
+* @param value The pivot value.
+* @param left Receives the values less than @p value.
+* @param right Receives the values greater than @p value.
+* @return The detached node equal to @p value, or nullptr if the value was absent.
+*/
+template <typename Node, typename T>
+Node* split(Node* root, const T& value, Node*& left, Node*& right)
+{
+    Node** low = &left;
+    Node** high = &right;
+    while (root != nullptr) {
+        if (value < root->data) {
+            *high = root;
+            high = &root->left;
+            root = root->left;
+        } else if (root->data < value) {
+            *low = root;
+            low = &root->right;
+            root = root->right;
+        } else {
+            *low = root->left;
+            *high = root->right;
+            root->left = root->right = nullptr;
+            return root;
+        }
+    }
+    *low = *high = nullptr;
+    return nullptr;
+}
+
+/**
+* @brief Inserts a detached node, keeping the hashed-treap shape.
+* @return True if the node was linked in, false if its value already existed.
+*/
+template <typename Node>
+bool insert(Node*& root, Node* node)
+{
+    if (find(root, node->data) != nullptr) {
+        return false;
+    }
+    Node* left;
+    Node* right;
+    split(root, node->data, left, right);
+    root = join(left, node, right);
+    return true;
+}
+
+/**
+* @brief Removes and deletes the node holding @p value.
+* @return True if a node was removed, false if the value was absent.
+*/
+template <typename Node, typename T>
+bool erase(Node*& root, const T& value)
+{
+    if (find(root, value) == nullptr) {
+        return false;
+    }
+    Node* left;
+    Node* right;
+    delete split(root, value, left, right);
+    root = join2(left, right);
+    return true;
+}
+
+namespace detail {
+
+/**
+* @brief Runs @p first and @p second, offering @p first to the shared pool while @p depth > 0.
+*
+* Both results must be default-constructible.
+*/
+template <typename First, typename Second>
+auto fork_join(unsigned depth, First first, Second second)
+{
+    if (depth == 0) {
+        auto a = first();
+        auto b = second();
+        return std::make_pair(a, b);
+    }
+    decltype(first()) a{};
+    decltype(second()) b{};
+    runtime::invoke([&] { a = first(); }, [&] { b = second(); });
+    return std::make_pair(a, b);
+}
+
+// Each helper returns the new root and how many nodes it deleted.
+template <typename Node>
+using Result = std::pair<Node*, size_t>;
+
+template <typename Node>
+Result<Node> unite(Node* a, Node* b, unsigned depth)
+{
+    if (a == nullptr) {
+        return {b, 0};
+    }
+    if (b == nullptr) {
+        return {a, 0};
+    }
+    if (priority(a->data) < priority(b->data)) {
+        std::swap(a, b);
+    }
+    Node* left;
+    Node* right;
+    Node* duplicate = split(b, a->data, left, right);
+    Node* a_left = a->left;
+    Node* a_right = a->right;
+    unsigned next = depth > 0 ? depth - 1 : 0;
+    auto [l, r] = fork_join(depth,
+        [=] { return unite(a_left, left, next); },
+        [=] { return unite(a_right, right, next); });
+    size_t dropped = l.second + r.second;
+    if (duplicate != nullptr) {
+        delete duplicate;
+        ++dropped;
+    }
+    return {join(l.first, a, r.first), dropped};
+}
+
+template <typename Node>
+Result<Node> intersect(Node* a, Node* b, unsigned depth)
+{
+    if (a == nullptr || b == nullptr) {
+        return {nullptr, destroy(a) + destroy(b)};
+    }
+    Node* left;
+    Node* right;
+    Node* match = split(b, a->data, left, right);
+    Node* a_left = a->left;
+    Node* a_right = a->right;
+    unsigned next = depth > 0 ? depth - 1 : 0;
+    auto [l, r] = fork_join(depth,
+        [=] { return intersect(a_left, left, next); },
+        [=] { return intersect(a_right, right, next); });
+    size_t dropped = l.second + r.second + 1;
+    if (match != nullptr) {
+        delete match;
+        return {join(l.first, a, r.first), dropped};
+    }
+    delete a;
+    return {join2(l.first, r.first), dropped};
+}
+
+template <typename Node>
+Result<Node> subtract(Node* a, Node* b, unsigned depth)
+{
+    if (a == nullptr || b == nullptr) {
+        return {a, destroy(b)};
+    }
+    Node* left;
+    Node* right;
+    Node* match = split(a, b->data, left, right);
+    Node* b_left = b->left;
+    Node* b_right = b->right;
+    unsigned next = depth > 0 ? depth - 1 : 0;
+    auto [l, r] = fork_join(depth,
+        [=] { return subtract(left, b_left, next); },
+        [=] { return subtract(right, b_right, next); });
+    size_t dropped = l.second + r.second + 1;
+    delete b;
+    if (match != nullptr) {
+        delete match;
+        ++dropped;
+    }
+    return {join2(l.first, r.first), dropped};
+}
+
+} // namespace detail
+
+/**
+* @brief Union of two trees. Both inputs are consumed and their nodes reused.
+*
+* Runs in O(m log(n/m + 1)) expected work for trees of sizes m <= n kept as
+* hashed treaps, forking the two recursive halves while @p fork_depth > 0.
+*
+* The set operations recurse once per level of the inputs. Trees built with
+* insert/erase/join/split are hashed treaps of expected O(log n) height;
+* other trees should go through rebalance() (hw09_bulk.h) first, since a
+* degenerate tree of n nodes recurses n deep.
+*
+* @return The new root and the number of duplicate nodes that were deleted.
+*/
+template <typename Node>
+std::pair<Node*, size_t> set_union(Node* a, Node* b, unsigned fork_depth = default_fork_depth())
+{
+    return detail::unite(a, b, fork_depth);
+}
+
+/**
+* @brief Intersection of two trees. Both inputs are consumed and their nodes reused.
+*
+* Same hashed-treap precondition as set_union(). The splits and joins take
+* the same O(m log(n/m + 1)) expected work, but every node left out of the
+* result is freed as well, so the total is O(m log(n/m + 1) + n + m):
+* intersecting 10 values with 100M frees the other 100M nodes.
+*
+* @return The new root and the number of nodes that were deleted.
+*/
+template <typename Node>
+std::pair<Node*, size_t> set_intersection(Node* a, Node* b, unsigned fork_depth = default_fork_depth())
+{
+    return detail::intersect(a, b, fork_depth);
+}
+
+/**
+* @brief Values of @p a that are not in @p b. Both inputs are consumed and their nodes reused.
+*
+* Same hashed-treap precondition as set_union(). Besides the
+* O(m log(n/m + 1)) expected work of the splits and joins, every node of
+* @p b is freed, so the total is O(m log(n/m + 1) + |b|).
+*
+* @return The new root and the number of nodes that were deleted.
+*/
+template <typename Node>
+std::pair<Node*, size_t> set_difference(Node* a, Node* b, unsigned fork_depth = default_fork_depth())
+{
+    return detail::subtract(a, b, fork_depth);
+}
+
+} // namespace bst
+
+} // namespace cppclass
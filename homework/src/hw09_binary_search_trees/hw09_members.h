@@ -0,0 +1,157 @@
+#pragma once
+
+// Out-of-class BinarySearchTree members built on the node-level bst:: functions.
+// They need the complete class, so hw09.h includes this header at its end.
+
+#include <cstddef> // for size_t
+#include <memory>  // for std::unique_ptr
+#include <ostream>
+
+#include "hw09.h"
+#include "hw09_bulk.h"
+#include "hw09_dump.h"
+#include "hw09_finger.h"
+#include "hw09_join.h"
+#include "hw09_verify.h"
+
+namespace cppclass {
+
+template <typename T>
+BinarySearchTree<T> BinarySearchTree<T>::set_union(BinarySearchTree&& lhs, BinarySearchTree&& rhs)
+{
+    if (&lhs == &rhs) {
+        return lhs.take();
+    }
+    size_t total = lhs.m_size + rhs.m_size;
+    auto [root, dropped] = bst::set_union(lhs.m_root, rhs.m_root);
+    lhs.m_root = rhs.m_root = nullptr;
+    lhs.m_size = rhs.m_size = 0;
+    lhs.modified();
+    rhs.modified();
+    // Every input node either ends up in the result or was deleted.
+    return BinarySearchTree(root, total - dropped);
+}
+
+template <typename T>
+BinarySearchTree<T> BinarySearchTree<T>::set_intersection(BinarySearchTree&& lhs, BinarySearchTree&& rhs)
+{
+    if (&lhs == &rhs) {
+        return lhs.take();
+    }
+    size_t total = lhs.m_size + rhs.m_size;
+    auto [root, dropped] = bst::set_intersection(lhs.m_root, rhs.m_root);
+    lhs.m_root = rhs.m_root = nullptr;
+    lhs.m_size = rhs.m_size = 0;
+    lhs.modified();
+    rhs.modified();
+    // Every input node either ends up in the result or was deleted.
+    return BinarySearchTree(root, total - dropped);
+}
+
+template <typename T>
+BinarySearchTree<T> BinarySearchTree<T>::set_difference(BinarySearchTree&& lhs, BinarySearchTree&& rhs)
+{
+    if (&lhs == &rhs) {
+        // Every value is in both operands, so every node goes.
+        bst::destroy(lhs.m_root);
+        lhs.m_root = nullptr;
+        lhs.m_size = 0;
+        lhs.modified();
+        return BinarySearchTree(static_cast<Node*>(nullptr), 0);
+    }
+    size_t total = lhs.m_size + rhs.m_size;
+    auto [root, dropped] = bst::set_difference(lhs.m_root, rhs.m_root);
+    lhs.m_root = rhs.m_root = nullptr;
+    lhs.m_size = rhs.m_size = 0;
+    lhs.modified();
+    rhs.modified();
+    // Every input node either ends up in the result or was deleted.
+    return BinarySearchTree(root, total - dropped);
+}
+
+template <typename T>
+bool BinarySearchTree<T>::verify(bool balanced) const
+{
+    bst::Verification facts = bst::verify(m_root);
+    return facts.ordered && facts.count == m_size && (!balanced || facts.heap_ordered);
+}
+
+template <typename T>
+void BinarySearchTree<T>::dump_in_order(std::ostream& out) const
+{
+    bst::Sink sink(out);
+    bst::dump_in_order(m_root, sink);
+}
+
+template <typename T>
+void BinarySearchTree<T>::dump_level_order(std::ostream& out) const
+{
+    bst::Sink sink(out);
+    bst::dump_level_order(m_root, sink);
+}
+
+template <typename T>
+void BinarySearchTree<T>::dump_sideways(std::ostream& out) const
+{
+    bst::Sink sink(out);
+    bst::dump_sideways(m_root, sink);
+}
+
+template <typename T>
+template <typename Visit>
+void BinarySearchTree<T>::for_each(Visit&& visit) const
+{
+    bst::for_each(m_root, visit);
+}
+
+template <typename T>
+template <typename Predicate>
+size_t BinarySearchTree<T>::remove_if(Predicate pred)
+{
+    // A throwing pred leaves every value in place, so m_size stays in step, but the
+    // nodes were relinked either way.
+    size_t removed;
+    try {
+        removed = bst::remove_if(m_root, pred);
+    } catch (...) {
+        modified();
+        throw;
+    }
+    m_size -= removed;
+    modified();
+    return removed;
+}
+
+template <typename T>
+size_t BinarySearchTree<T>::remove_batch(const T* sorted_keys, size_t count)
+{
+    // If the rebuild's memory cannot be had, nothing is removed but the nodes were relinked.
+    size_t removed;
+    try {
+        removed = bst::remove_batch(m_root, sorted_keys, count);
+    } catch (...) {
+        modified();
+        throw;
+    }
+    m_size -= removed;
+    modified();
+    return removed;
+}
+
+template <typename T>
+bool BinarySearchTree<T>::insert_hint(Finger& hint, T value)
+{
+    hint.sync(m_version, m_size);
+    if (hint.seek(m_root, value)) {
+        return false;
+    }
+    std::unique_ptr<Node> node(new Node(value));
+    hint.link(m_root, node.get());
+    node.release();
+    ++m_size;
+    modified();
+    hint.advance(m_version, m_size);
+    return true;
+}
+
+} // namespace cppclass
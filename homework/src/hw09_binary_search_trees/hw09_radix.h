@@ -0,0 +1,1033 @@
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint8_t, uint32_t, uintptr_t
+#include <cstring>     // for memcpy, memmove
+#include <memory>      // for std::unique_ptr
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>     // for std::swap
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace cppclass {
+namespace radix {
+
+/**
+* @brief Byte view of a key in the order the radix tree sorts by.
+*
+* Strings are used as-is. Integers are stored big-endian with the sign bit
+* flipped, so that byte-wise order matches numeric order.
+*/
+template <typename Key, typename = void>
+class KeyBytes;
+
+template <>
+class KeyBytes<std::string> {
+public:
+    explicit KeyBytes(const std::string& key) : m_view(key) {}
+    const unsigned char* data() const { return reinterpret_cast<const unsigned char*>(m_view.data()); }
+    size_t size() const { return m_view.size(); }
+
+    static std::string decode(const unsigned char* bytes, size_t len)
+    {
+        return std::string(reinterpret_cast<const char*>(bytes), len);
+    }
+
+private:
+    std::string_view m_view;
+};
+
+template <typename Key>
+class KeyBytes<Key, std::enable_if_t<std::is_integral_v<Key>>> {
+public:
+    explicit KeyBytes(Key key)
+    {
+        using Unsigned = std::make_unsigned_t<Key>;
+        Unsigned bits = static_cast<Unsigned>(key);
+        if constexpr (std::is_signed_v<Key>) {
+            bits ^= Unsigned(1) << (sizeof(Key) * 8 - 1);
+        }
+        for (size_t i = sizeof(Key); i-- > 0;) {
+            m_bytes[i] = static_cast<unsigned char>(bits);
+            bits = static_cast<Unsigned>(bits >> 8);
+        }
+    }
+    const unsigned char* data() const { return m_bytes; }
+    size_t size() const { return sizeof(Key); }
+
+    static Key decode(const unsigned char* bytes, size_t)
+    {
+        using Unsigned = std::make_unsigned_t<Key>;
+        Unsigned bits = 0;
+        for (size_t i = 0; i < sizeof(Key); ++i) {
+            bits = static_cast<Unsigned>((bits << 8) | bytes[i]);
+        }
+        if constexpr (std::is_signed_v<Key>) {
+            bits ^= Unsigned(1) << (sizeof(Key) * 8 - 1);
+        }
+        return static_cast<Key>(bits);
+    }
+
+private:
+    unsigned char m_bytes[sizeof(Key)];
+};
+
+} // namespace radix
+
+/**
+* @brief Adaptive radix tree (ART) with the BinarySearchTree interface.
+*
+* Keys are split into bytes and each inner node branches on one byte, so a
+* lookup costs O(key length) regardless of how many keys are stored. Inner
+* nodes grow through four layouts (4, 16, 48 and 256 children) as they fill,
+* and chains of single-child nodes are compressed into a prefix (inline up
+* to eight bytes, on the heap beyond that).
+*
+* Keys are not stored whole. A leaf holds only the bytes below the point
+* where it hangs, in one allocation with its length, and a key that ends at
+* an inner node is a flag on that node. Bytes shared with other keys are
+* therefore stored once, in the inner nodes' prefixes and edges, and for_each()
+* rebuilds each key from the path. For URL-like strings this takes well
+* under half the memory of BinarySearchTree<std::string> (see the HW09Radix
+* memory test).
+*
+* @tparam Key std::string or an integral type.
+*/
+template <typename Key>
+class RadixTree {
+public:
+    /**
+    * @brief An empty RadixTree will be created.
+    */
+    RadixTree() : m_root(nullptr), m_size(0) {}
+
+    /**
+    * @brief Copy constructor for RadixTree.
+    * @param other Reference to RadixTree to copy from.
+    */
+    RadixTree(const RadixTree& other) : RadixTree()
+    {
+        other.for_each([this](const Key& key) { insert(key); });
+    }
+
+    /**
+    * @brief Move constructor for RadixTree.
+    * @param other R-value reference to another RadixTree object.
+    */
+    RadixTree(RadixTree&& other) noexcept : m_root(other.m_root), m_size(other.m_size)
+    {
+        other.m_root = nullptr;
+        other.m_size = 0;
+    }
+
+    /**
+    * @brief Copy assignment. Builds the copy first, so on exception *this is unchanged.
+    * @param other Reference to RadixTree to copy from.
+    */
+    RadixTree& operator=(const RadixTree& other)
+    {
+        RadixTree(other).swap(*this);
+        return *this;
+    }
+
+    /**
+    * @brief Move assignment.
+    * @param other R-value reference to another RadixTree object. Left empty.
+    */
+    RadixTree& operator=(RadixTree&& other) noexcept
+    {
+        RadixTree(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    /**
+    * @brief Exchanges the contents of two trees.
+    */
+    void swap(RadixTree& other) noexcept
+    {
+        std::swap(m_root, other.m_root);
+        std::swap(m_size, other.m_size);
+    }
+
+    friend void swap(RadixTree& a, RadixTree& b) noexcept
+    {
+        a.swap(b);
+    }
+
+    /**
+    * @brief Destructor for RadixTree.
+    */
+    ~RadixTree()
+    {
+        destroy(m_root);
+    }
+
+    /**
+    * @brief Inserts a key into the tree.
+    * @param key The key to insert. Cannot be a duplicate.
+    * @return True if the key was inserted successfully, false if it already exists.
+    */
+    bool insert(const Key& key)
+    {
+        radix::KeyBytes<Key> bytes(key);
+        const unsigned char* k = bytes.data();
+        size_t len = bytes.size();
+        Ref* slot = &m_root;
+        size_t depth = 0;
+
+        for (;;) {
+            Ref node = *slot;
+            if (node == nullptr) {
+                *slot = make_leaf(k + depth, len - depth);
+                break;
+            }
+            if (is_leaf(node)) {
+                Leaf* existing = as_leaf(node);
+                const unsigned char* o = existing->bytes();
+                size_t rest = len - depth;
+                if (matches(existing, k + depth, rest)) {
+                    return false;
+                }
+                size_t common = 0;
+                while (common < rest && common < existing->len && k[depth + common] == o[common]) {
+                    ++common;
+                }
+                // Everything that can throw happens before the branch is linked in.
+                auto branch = std::make_unique<Node4>();
+                set_prefix(branch.get(), k + depth, common);
+                LeafPtr old_rest = suffix_leaf(o + common, existing->len - common);
+                LeafPtr new_rest = suffix_leaf(k + depth + common, rest - common);
+                hang(branch.get(), o + common, existing->len - common, std::move(old_rest));
+                hang(branch.get(), k + depth + common, rest - common, std::move(new_rest));
+                free_leaf(existing);
+                *slot = branch.release();
+                break;
+            }
+
+            Inner* inner = as_inner(node);
+            if (inner->prefix_len > 0) {
+                size_t mismatch = prefix_mismatch(inner, k + depth, len - depth);
+                if (mismatch < inner->prefix_len) {
+                    auto branch = std::make_unique<Node4>();
+                    set_prefix(branch.get(), k + depth, mismatch);
+                    LeafPtr rest = suffix_leaf(k + depth + mismatch, len - depth - mismatch);
+                    unsigned char edge = inner->prefix()[mismatch];
+                    // The last step that can throw; inner keeps its old prefix if it does.
+                    set_prefix(inner, inner->prefix() + mismatch + 1, inner->prefix_len - mismatch - 1);
+                    Ref self = branch.get();
+                    add_child(&self, edge, node);
+                    hang(branch.get(), k + depth + mismatch, len - depth - mismatch, std::move(rest));
+                    *slot = branch.release();
+                    break;
+                }
+                depth += inner->prefix_len;
+            }
+            if (depth == len) {
+                if (inner->terminal) {
+                    return false;
+                }
+                inner->terminal = true;
+                break;
+            }
+            Ref* child = find_child(inner, k[depth]);
+            if (child == nullptr) {
+                // add_child may grow the node and throw; the leaf is owned until it is linked.
+                LeafPtr leaf = new_leaf(k + depth + 1, len - depth - 1);
+                add_child(slot, k[depth], tag(leaf.get()));
+                leaf.release();
+                break;
+            }
+            slot = child;
+            ++depth;
+        }
+        ++m_size;
+        return true;
+    }
+
+    /**
+    * @brief Removes a key from the tree.
+    * @param key The key to remove.
+    * @return True if the key was removed successfully, false if it was not found.
+    */
+    bool remove(const Key& key)
+    {
+        radix::KeyBytes<Key> bytes(key);
+        const unsigned char* k = bytes.data();
+        size_t len = bytes.size();
+        Ref* parent = nullptr;
+        Ref* slot = &m_root;
+        unsigned char edge = 0;
+        size_t depth = 0;
+
+        for (;;) {
+            Ref node = *slot;
+            if (node == nullptr) {
+                return false;
+            }
+            if (is_leaf(node)) {
+                if (!matches(as_leaf(node), k + depth, len - depth)) {
+                    return false;
+                }
+                if (parent == nullptr) {
+                    free_leaf(as_leaf(node));
+                    *slot = nullptr;
+                } else {
+                    remove_leaf(parent, edge);
+                }
+                break;
+            }
+            Inner* inner = as_inner(node);
+            if (prefix_mismatch(inner, k + depth, len - depth) < inner->prefix_len) {
+                return false;
+            }
+            depth += inner->prefix_len;
+            if (depth == len) {
+                if (!inner->terminal) {
+                    return false;
+                }
+                if (inner->kind == Kind::Node4 && inner->count == 1) {
+                    // Only the child is left, so the node merges into it.
+                    Merge merge = prepare_merge(static_cast<Node4*>(inner), nullptr);
+                    apply_merge(slot, static_cast<Node4*>(inner), merge);
+                } else {
+                    inner->terminal = false;
+                }
+                break;
+            }
+            edge = k[depth];
+            parent = slot;
+            slot = find_child(inner, edge);
+            if (slot == nullptr) {
+                return false;
+            }
+            ++depth;
+        }
+        --m_size;
+        return true;
+    }
+
+    /**
+    * @brief Checks if a key is contained in the tree.
+    * @param key The key to check.
+    * @return True if the key is found, false otherwise.
+    */
+    bool contains(const Key& key) const
+    {
+        radix::KeyBytes<Key> bytes(key);
+        const unsigned char* k = bytes.data();
+        size_t len = bytes.size();
+        Ref node = m_root;
+        size_t depth = 0;
+
+        while (node != nullptr) {
+            if (is_leaf(node)) {
+                return matches(as_leaf(node), k + depth, len - depth);
+            }
+            const Inner* inner = as_inner(node);
+            if (depth + inner->prefix_len > len
+                || std::memcmp(inner->prefix(), k + depth, inner->prefix_len) != 0) {
+                return false;
+            }
+            depth += inner->prefix_len;
+            if (depth == len) {
+                return inner->terminal;
+            }
+            Ref* child = find_child(const_cast<Inner*>(inner), k[depth]);
+            node = child != nullptr ? *child : nullptr;
+            ++depth;
+        }
+        return false;
+    }
+
+    /**
+    * @brief Returns the size of the tree.
+    * @return The number of keys in the tree.
+    */
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+    * @brief Visits every key in ascending order.
+    * @param visit Callable invoked as visit(const Key&).
+    */
+    template <typename Visit>
+    void for_each(Visit&& visit) const
+    {
+        std::string path;
+        walk(m_root, path, visit);
+    }
+
+    /**
+    * @brief Visits, in ascending order, every key that starts with @p prefix.
+    * @param prefix The prefix to match. An empty prefix visits every key.
+    * @param visit Callable invoked as visit(const std::string&).
+    */
+    template <typename Visit>
+    void scan_prefix(std::string_view prefix, Visit&& visit) const
+        requires std::is_same_v<Key, std::string>
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(prefix.data());
+        Ref node = m_root;
+        size_t depth = 0;
+        std::string path;
+
+        while (node != nullptr && !is_leaf(node)) {
+            const Inner* inner = as_inner(node);
+            size_t rest = prefix.size() - depth;
+            size_t shared = inner->prefix_len < rest ? inner->prefix_len : rest;
+            if (std::memcmp(inner->prefix(), p + depth, shared) != 0) {
+                return;
+            }
+            if (inner->prefix_len >= rest) {
+                break;
+            }
+            path.append(reinterpret_cast<const char*>(inner->prefix()), inner->prefix_len);
+            depth += inner->prefix_len;
+            Ref* child = find_child(const_cast<Inner*>(inner), p[depth]);
+            if (child == nullptr) {
+                return;
+            }
+            path.push_back(static_cast<char>(p[depth]));
+            node = *child;
+            ++depth;
+        }
+        // A leaf reached before the prefix ran out may still differ in its suffix.
+        auto matching = [&](const std::string& key) {
+            if (key.compare(0, prefix.size(), prefix) == 0) {
+                visit(key);
+            }
+        };
+        walk(node, path, matching);
+    }
+
+    /**
+    * @brief Checks if two trees hold the same keys.
+    * @param other The other tree to compare with.
+    * @return True if the trees are equal, false otherwise.
+    */
+    bool operator==(const RadixTree& other) const
+    {
+        if (m_size != other.m_size) {
+            return false;
+        }
+        bool same = true;
+        for_each([&](const Key& key) { same = same && other.contains(key); });
+        return same;
+    }
+
+    /**
+    * @brief Checks if the tree is not equal to another tree.
+    * @param other The other tree to compare with.
+    * @return True if the trees are not equal, false otherwise.
+    */
+    bool operator!=(const RadixTree& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    static constexpr size_t kInlinePrefix = 8;
+
+    // A child reference is either an Inner* or a Leaf* tagged in its low bit.
+    using Ref = void*;
+
+    /**
+    * @brief The key bytes below the point where the leaf hangs, stored right after the length.
+    */
+    struct Leaf {
+        uint32_t len;
+
+        const unsigned char* bytes() const { return reinterpret_cast<const unsigned char*>(this + 1); }
+    };
+
+    enum class Kind : uint8_t { Node4, Node16, Node48, Node256 };
+
+    struct Inner {
+        Kind kind;
+        bool terminal = false;   ///< A key ends exactly at this node, after its prefix.
+        uint16_t count = 0;      ///< Number of children.
+        uint32_t prefix_len = 0; ///< Length of the compressed path above the branch byte.
+        union {
+            unsigned char inline_prefix[kInlinePrefix] = {};
+            unsigned char* heap_prefix; ///< Owned; used when prefix_len > kInlinePrefix.
+        };
+
+        explicit Inner(Kind k) : kind(k) {}
+
+        ~Inner()
+        {
+            if (prefix_len > kInlinePrefix) {
+                delete[] heap_prefix;
+            }
+        }
+
+        const unsigned char* prefix() const
+        {
+            return prefix_len <= kInlinePrefix ? inline_prefix : heap_prefix;
+        }
+    };
+
+    struct Node4 : Inner {
+        unsigned char keys[4] = {};
+        Ref children[4] = {};
+        Node4() : Inner(Kind::Node4) {}
+    };
+
+    struct Node16 : Inner {
+        unsigned char keys[16] = {};
+        Ref children[16] = {};
+        Node16() : Inner(Kind::Node16) {}
+    };
+
+    struct Node48 : Inner {
+        unsigned char index[256] = {}; ///< 0 when empty, otherwise slot + 1.
+        Ref children[48] = {};
+        Node48() : Inner(Kind::Node48) {}
+    };
+
+    struct Node256 : Inner {
+        Ref children[256] = {};
+        Node256() : Inner(Kind::Node256) {}
+    };
+
+    static bool is_leaf(Ref ref) { return (reinterpret_cast<uintptr_t>(ref) & 1) != 0; }
+    static Leaf* as_leaf(Ref ref) { return reinterpret_cast<Leaf*>(reinterpret_cast<uintptr_t>(ref) & ~uintptr_t(1)); }
+    static Inner* as_inner(Ref ref) { return static_cast<Inner*>(ref); }
+    static Ref tag(Leaf* leaf) { return reinterpret_cast<Ref>(reinterpret_cast<uintptr_t>(leaf) | 1); }
+
+    static void free_leaf(Leaf* leaf)
+    {
+        ::operator delete(leaf);
+    }
+
+    struct FreeLeaf {
+        void operator()(Leaf* leaf) const { free_leaf(leaf); }
+    };
+    using LeafPtr = std::unique_ptr<Leaf, FreeLeaf>;
+
+    // A leaf for len bytes, which the caller fills in through leaf_bytes().
+    static LeafPtr alloc_leaf(size_t len)
+    {
+        return LeafPtr(new (::operator new(sizeof(Leaf) + len)) Leaf{static_cast<uint32_t>(len)});
+    }
+
+    static unsigned char* leaf_bytes(Leaf* leaf)
+    {
+        return reinterpret_cast<unsigned char*>(leaf + 1);
+    }
+
+    static LeafPtr new_leaf(const unsigned char* bytes, size_t len)
+    {
+        LeafPtr leaf = alloc_leaf(len);
+        std::memcpy(leaf_bytes(leaf.get()), bytes, len);
+        return leaf;
+    }
+
+    static Ref make_leaf(const unsigned char* bytes, size_t len)
+    {
+        return tag(new_leaf(bytes, len).release());
+    }
+
+    static bool matches(const Leaf* leaf, const unsigned char* bytes, size_t len)
+    {
+        return leaf->len == len && std::memcmp(leaf->bytes(), bytes, len) == 0;
+    }
+
+    // Replaces the prefix; bytes may point into the current prefix.
+    static void set_prefix(Inner* node, const unsigned char* bytes, size_t len)
+    {
+        unsigned char* heap = nullptr;
+        unsigned char small[kInlinePrefix] = {};
+        // Integral keys never need the heap; saying so keeps GCC from flagging the dead branch.
+        constexpr bool fits_inline = std::is_integral_v<Key> && sizeof(Key) <= kInlinePrefix;
+        if (!fits_inline && len > kInlinePrefix) {
+            heap = new unsigned char[len];
+            std::memcpy(heap, bytes, len);
+        } else {
+            std::memcpy(small, bytes, len);
+        }
+        release_prefix(node);
+        node->prefix_len = static_cast<uint32_t>(len);
+        if (heap != nullptr) {
+            node->heap_prefix = heap;
+        } else {
+            std::memcpy(node->inline_prefix, small, kInlinePrefix);
+        }
+    }
+
+    static void release_prefix(Inner* node)
+    {
+        if (node->prefix_len > kInlinePrefix) {
+            delete[] node->heap_prefix;
+        }
+        node->prefix_len = 0;
+    }
+
+    // The leaf hang() needs for the remaining key bytes (bytes, len); none if they are used up.
+    static LeafPtr suffix_leaf(const unsigned char* bytes, size_t len)
+    {
+        return len == 0 ? nullptr : new_leaf(bytes + 1, len - 1);
+    }
+
+    // Hangs the key whose remaining bytes are (bytes, len) below a fresh branch. Cannot throw:
+    // the leaf comes from suffix_leaf() and a fresh Node4 has room.
+    static void hang(Node4* branch, const unsigned char* bytes, size_t len, LeafPtr leaf)
+    {
+        if (len == 0) {
+            branch->terminal = true;
+        } else {
+            Ref self = branch;
+            add_child(&self, bytes[0], tag(leaf.release()));
+        }
+    }
+
+    // Position within the node's prefix where the key (bytes, len) diverges or runs out.
+    static size_t prefix_mismatch(const Inner* node, const unsigned char* bytes, size_t len)
+    {
+        size_t limit = node->prefix_len < len ? node->prefix_len : len;
+        const unsigned char* prefix = node->prefix();
+        for (size_t i = 0; i < limit; ++i) {
+            if (prefix[i] != bytes[i]) {
+                return i;
+            }
+        }
+        return limit;
+    }
+
+    static Ref* find_child(Inner* node, unsigned char byte)
+    {
+        switch (node->kind) {
+        case Kind::Node4: {
+            Node4* n = static_cast<Node4*>(node);
+            for (unsigned i = 0; i < n->count; ++i) {
+                if (n->keys[i] == byte) {
+                    return &n->children[i];
+                }
+            }
+            return nullptr;
+        }
+        case Kind::Node16: {
+            Node16* n = static_cast<Node16*>(node);
+#if defined(__SSE2__)
+            __m128i hits = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)),
+                                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys)));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits)) & ((1u << n->count) - 1);
+            return mask != 0 ? &n->children[__builtin_ctz(mask)] : nullptr;
+#else
+            for (unsigned i = 0; i < n->count; ++i) {
+                if (n->keys[i] == byte) {
+                    return &n->children[i];
+                }
+            }
+            return nullptr;
+#endif
+        }
+        case Kind::Node48: {
+            Node48* n = static_cast<Node48*>(node);
+            return n->index[byte] != 0 ? &n->children[n->index[byte] - 1] : nullptr;
+        }
+        case Kind::Node256: {
+            Node256* n = static_cast<Node256*>(node);
+            return n->children[byte] != nullptr ? &n->children[byte] : nullptr;
+        }
+        }
+        return nullptr;
+    }
+
+    static Ref first_child(Inner* node)
+    {
+        switch (node->kind) {
+        case Kind::Node4:
+            return static_cast<Node4*>(node)->children[0];
+        case Kind::Node16:
+            return static_cast<Node16*>(node)->children[0];
+        case Kind::Node48: {
+            Node48* n = static_cast<Node48*>(node);
+            for (unsigned b = 0; b < 256; ++b) {
+                if (n->index[b] != 0) {
+                    return n->children[n->index[b] - 1];
+                }
+            }
+            return nullptr;
+        }
+        case Kind::Node256: {
+            Node256* n = static_cast<Node256*>(node);
+            for (unsigned b = 0; b < 256; ++b) {
+                if (n->children[b] != nullptr) {
+                    return n->children[b];
+                }
+            }
+            return nullptr;
+        }
+        }
+        return nullptr;
+    }
+
+    static void copy_header(Inner* to, Inner* from)
+    {
+        // Takes over a heap prefix too, so the old node's destructor must not free it.
+        to->count = from->count;
+        to->prefix_len = from->prefix_len;
+        std::memcpy(to->inline_prefix, from->inline_prefix, kInlinePrefix);
+        to->terminal = from->terminal;
+        from->prefix_len = 0;
+    }
+
+    // Inserts into a sorted key/child array of a Node4 or Node16.
+    template <typename Small>
+    static void insert_sorted(Small* n, unsigned char byte, Ref child)
+    {
+        unsigned i = 0;
+        while (i < n->count && n->keys[i] < byte) {
+            ++i;
+        }
+        std::memmove(n->keys + i + 1, n->keys + i, n->count - i);
+        std::memmove(n->children + i + 1, n->children + i, (n->count - i) * sizeof(Ref));
+        n->keys[i] = byte;
+        n->children[i] = child;
+        ++n->count;
+    }
+
+    // Adds a child to the inner node stored at *slot, growing it if full.
+    static void add_child(Ref* slot, unsigned char byte, Ref child)
+    {
+        Inner* node = as_inner(*slot);
+        switch (node->kind) {
+        case Kind::Node4: {
+            Node4* n = static_cast<Node4*>(node);
+            if (n->count < 4) {
+                insert_sorted(n, byte, child);
+                return;
+            }
+            Node16* grown = new Node16();
+            copy_header(grown, n);
+            std::memcpy(grown->keys, n->keys, 4);
+            std::memcpy(grown->children, n->children, 4 * sizeof(Ref));
+            delete n;
+            *slot = grown;
+            insert_sorted(grown, byte, child);
+            return;
+        }
+        case Kind::Node16: {
+            Node16* n = static_cast<Node16*>(node);
+            if (n->count < 16) {
+                insert_sorted(n, byte, child);
+                return;
+            }
+            Node48* grown = new Node48();
+            copy_header(grown, n);
+            for (unsigned i = 0; i < 16; ++i) {
+                grown->index[n->keys[i]] = static_cast<unsigned char>(i + 1);
+                grown->children[i] = n->children[i];
+            }
+            delete n;
+            *slot = grown;
+            add_child(slot, byte, child);
+            return;
+        }
+        case Kind::Node48: {
+            Node48* n = static_cast<Node48*>(node);
+            if (n->count < 48) {
+                unsigned free_slot = 0;
+                while (n->children[free_slot] != nullptr) {
+                    ++free_slot;
+                }
+                n->children[free_slot] = child;
+                n->index[byte] = static_cast<unsigned char>(free_slot + 1);
+                ++n->count;
+                return;
+            }
+            Node256* grown = new Node256();
+            copy_header(grown, n);
+            for (unsigned b = 0; b < 256; ++b) {
+                if (n->index[b] != 0) {
+                    grown->children[b] = n->children[n->index[b] - 1];
+                }
+            }
+            delete n;
+            *slot = grown;
+            add_child(slot, byte, child);
+            return;
+        }
+        case Kind::Node256: {
+            Node256* n = static_cast<Node256*>(node);
+            n->children[byte] = child;
+            ++n->count;
+            return;
+        }
+        }
+    }
+
+    // Removes a sorted key/child entry from a Node4 or Node16.
+    template <typename Small>
+    static void erase_sorted(Small* n, unsigned char byte)
+    {
+        unsigned i = 0;
+        while (n->keys[i] != byte) {
+            ++i;
+        }
+        --n->count;
+        std::memmove(n->keys + i, n->keys + i + 1, n->count - i);
+        std::memmove(n->children + i, n->children + i + 1, (n->count - i) * sizeof(Ref));
+        n->keys[n->count] = 0;
+        n->children[n->count] = nullptr;
+    }
+
+    // Removes the leaf on byte from the inner node at *slot, shrinking the node if sparse and
+    // merging it into its last entry if only one is left. Every allocation comes before the
+    // first change, so if one throws the tree is as it was.
+    static void remove_leaf(Ref* slot, unsigned char byte)
+    {
+        Inner* node = as_inner(*slot);
+        Leaf* leaf = as_leaf(*find_child(node, byte));
+        switch (node->kind) {
+        case Kind::Node4: {
+            Node4* n = static_cast<Node4*>(node);
+            if (n->count - 1 + (n->terminal ? 1 : 0) == 1) {
+                Merge merge = prepare_merge(n, find_child(n, byte));
+                apply_merge(slot, n, merge);
+            } else {
+                erase_sorted(n, byte);
+            }
+            break;
+        }
+        case Kind::Node16: {
+            Node16* n = static_cast<Node16*>(node);
+            if (n->count > 4) {
+                erase_sorted(n, byte);
+                break;
+            }
+            auto shrunk = std::make_unique<Node4>();
+            erase_sorted(n, byte);
+            copy_header(shrunk.get(), n);
+            std::memcpy(shrunk->keys, n->keys, n->count);
+            std::memcpy(shrunk->children, n->children, n->count * sizeof(Ref));
+            delete n;
+            *slot = shrunk.release();
+            break;
+        }
+        case Kind::Node48: {
+            Node48* n = static_cast<Node48*>(node);
+            std::unique_ptr<Node16> shrunk = n->count <= 13 ? std::make_unique<Node16>() : nullptr;
+            n->children[n->index[byte] - 1] = nullptr;
+            n->index[byte] = 0;
+            --n->count;
+            if (shrunk != nullptr) {
+                copy_header(shrunk.get(), n);
+                unsigned j = 0;
+                for (unsigned b = 0; b < 256; ++b) {
+                    if (n->index[b] != 0) {
+                        shrunk->keys[j] = static_cast<unsigned char>(b);
+                        shrunk->children[j++] = n->children[n->index[b] - 1];
+                    }
+                }
+                delete n;
+                *slot = shrunk.release();
+            }
+            break;
+        }
+        case Kind::Node256: {
+            Node256* n = static_cast<Node256*>(node);
+            std::unique_ptr<Node48> shrunk = n->count <= 38 ? std::make_unique<Node48>() : nullptr;
+            n->children[byte] = nullptr;
+            --n->count;
+            if (shrunk != nullptr) {
+                copy_header(shrunk.get(), n);
+                unsigned j = 0;
+                for (unsigned b = 0; b < 256; ++b) {
+                    if (n->children[b] != nullptr) {
+                        shrunk->index[b] = static_cast<unsigned char>(j + 1);
+                        shrunk->children[j++] = n->children[b];
+                    }
+                }
+                delete n;
+                *slot = shrunk.release();
+            }
+            break;
+        }
+        }
+        free_leaf(leaf);
+    }
+
+    /**
+    * @brief What replaces a Node4 left with a single entry, allocated ahead of the change.
+    *
+    * Either a leaf holding the node's prefix (and, if the entry is a leaf, the
+    * edge byte and that leaf's bytes), or the entry's inner node with the
+    * merged prefix ready to install.
+    */
+    struct Merge {
+        LeafPtr leaf;
+        Leaf* replaced = nullptr; ///< Old leaf entry the new leaf supersedes.
+        Inner* child = nullptr;
+        std::unique_ptr<unsigned char[]> heap; ///< Merged prefix when it does not fit inline.
+        unsigned char small[kInlinePrefix] = {};
+        uint32_t len = 0;
+    };
+
+    // Builds the Merge for n once the entry at gone (if any) is removed: whatever is left is
+    // either the key ending at n or one child. Allocates but does not change the tree.
+    static Merge prepare_merge(const Node4* n, const Ref* gone)
+    {
+        Merge merge;
+        unsigned i = 0;
+        while (i < n->count && &n->children[i] == gone) {
+            ++i;
+        }
+        if (i == n->count) {
+            merge.leaf = new_leaf(n->prefix(), n->prefix_len);
+            return merge;
+        }
+        // The entry's bytes grow by this node's prefix and the edge byte.
+        auto fill = [&](unsigned char* out, const unsigned char* tail, size_t tail_len) {
+            std::memcpy(out, n->prefix(), n->prefix_len);
+            out[n->prefix_len] = n->keys[i];
+            std::memcpy(out + n->prefix_len + 1, tail, tail_len);
+        };
+        if (is_leaf(n->children[i])) {
+            merge.replaced = as_leaf(n->children[i]);
+            merge.leaf = alloc_leaf(n->prefix_len + 1 + merge.replaced->len);
+            fill(leaf_bytes(merge.leaf.get()), merge.replaced->bytes(), merge.replaced->len);
+        } else {
+            merge.child = as_inner(n->children[i]);
+            merge.len = n->prefix_len + 1 + merge.child->prefix_len;
+            unsigned char* out = merge.small;
+            if (merge.len > kInlinePrefix) {
+                merge.heap.reset(new unsigned char[merge.len]);
+                out = merge.heap.get();
+            }
+            fill(out, merge.child->prefix(), merge.child->prefix_len);
+        }
+        return merge;
+    }
+
+    // Puts a prepared Merge in place of n at *slot and frees what it supersedes. Cannot throw.
+    static void apply_merge(Ref* slot, Node4* n, Merge& merge)
+    {
+        if (merge.leaf != nullptr) {
+            *slot = tag(merge.leaf.release());
+            if (merge.replaced != nullptr) {
+                free_leaf(merge.replaced);
+            }
+        } else {
+            Inner* child = merge.child;
+            release_prefix(child);
+            child->prefix_len = merge.len;
+            if (merge.heap != nullptr) {
+                child->heap_prefix = merge.heap.release();
+            } else {
+                std::memcpy(child->inline_prefix, merge.small, kInlinePrefix);
+            }
+            *slot = child;
+        }
+        delete n;
+    }
+
+    // Visits the keys below node in order; path holds the key bytes above it.
+    template <typename Visit>
+    static void walk(Ref node, std::string& path, Visit& visit)
+    {
+        if (node == nullptr) {
+            return;
+        }
+        size_t mark = path.size();
+        auto key = [&] {
+            return radix::KeyBytes<Key>::decode(reinterpret_cast<const unsigned char*>(path.data()), path.size());
+        };
+        if (is_leaf(node)) {
+            const Leaf* leaf = as_leaf(node);
+            path.append(reinterpret_cast<const char*>(leaf->bytes()), leaf->len);
+            visit(key());
+            path.resize(mark);
+            return;
+        }
+        Inner* inner = as_inner(node);
+        path.append(reinterpret_cast<const char*>(inner->prefix()), inner->prefix_len);
+        if (inner->terminal) {
+            visit(key());
+        }
+        auto down = [&](unsigned char byte, Ref child) {
+            path.push_back(static_cast<char>(byte));
+            walk(child, path, visit);
+            path.pop_back();
+        };
+        switch (inner->kind) {
+        case Kind::Node4:
+            for (unsigned i = 0; i < inner->count; ++i) {
+                down(static_cast<Node4*>(inner)->keys[i], static_cast<Node4*>(inner)->children[i]);
+            }
+            break;
+        case Kind::Node16:
+            for (unsigned i = 0; i < inner->count; ++i) {
+                down(static_cast<Node16*>(inner)->keys[i], static_cast<Node16*>(inner)->children[i]);
+            }
+            break;
+        case Kind::Node48: {
+            Node48* n = static_cast<Node48*>(inner);
+            for (unsigned b = 0; b < 256; ++b) {
+                if (n->index[b] != 0) {
+                    down(static_cast<unsigned char>(b), n->children[n->index[b] - 1]);
+                }
+            }
+            break;
+        }
+        case Kind::Node256:
+            for (unsigned b = 0; b < 256; ++b) {
+                if (static_cast<Node256*>(inner)->children[b] != nullptr) {
+                    down(static_cast<unsigned char>(b), static_cast<Node256*>(inner)->children[b]);
+                }
+            }
+            break;
+        }
+        path.resize(mark);
+    }
+
+    static void destroy(Ref node)
+    {
+        if (node == nullptr) {
+            return;
+        }
+        if (is_leaf(node)) {
+            free_leaf(as_leaf(node));
+            return;
+        }
+        Inner* inner = as_inner(node);
+        switch (inner->kind) {
+        case Kind::Node4:
+            for (Ref child : static_cast<Node4*>(inner)->children) {
+                destroy(child);
+            }
+            delete static_cast<Node4*>(inner);
+            break;
+        case Kind::Node16:
+            for (Ref child : static_cast<Node16*>(inner)->children) {
+                destroy(child);
+            }
+            delete static_cast<Node16*>(inner);
+            break;
+        case Kind::Node48:
+            for (Ref child : static_cast<Node48*>(inner)->children) {
+                destroy(child);
+            }
+            delete static_cast<Node48*>(inner);
+            break;
+        case Kind::Node256:
+            for (Ref child : static_cast<Node256*>(inner)->children) {
+                destroy(child);
+            }
+            delete static_cast<Node256*>(inner);
+            break;
+        }
+    }
+
+    Ref m_root;
+    size_t m_size;
+};
+
+} // namespace cppclass
@@ -0,0 +1,457 @@
+#pragma once
+
+#include <cstddef> // for size_t
+#include <memory>  // for std::allocator
+#include <memory_resource>
+#include <type_traits>
+#include <utility> // for std::swap
+#include <vector>
+
+#include "hw09.h"
+#include "hw09_join.h"
+#include "policies.h"
+
+namespace cppclass {
+namespace bst {
+
+/**
+* @brief Top-down splay: brings the node closest to @p value to the root.
+*
+* If @p value is present its node becomes the root, otherwise the last node
+* visited on the search path does. Runs in amortized O(log n).
+*
+* @param root The tree to splay. May be nullptr.
+* @param value The value to search for.
+* @return The new root.
+*/
+template <typename Node, typename T>
+Node* splay(Node* root, const T& value)
+{
+    if (root == nullptr) {
+        return nullptr;
+    }
+    Node* left_tree = nullptr;
+    Node* right_tree = nullptr;
+    Node** left_max = &left_tree;  // right-child slot of the largest node in left_tree
+    Node** right_min = &right_tree; // left-child slot of the smallest node in right_tree
+
+    for (;;) {
+        if (value < root->data) {
+            if (root->left == nullptr) {
+                break;
+            }
+            if (value < root->left->data) {
+                Node* child = root->left;
+                root->left = child->right;
+                child->right = root;
+                root = child;
+                if (root->left == nullptr) {
+                    break;
+                }
+            }
+            *right_min = root;
+            right_min = &root->left;
+            root = root->left;
+        } else if (root->data < value) {
+            if (root->right == nullptr) {
+                break;
+            }
+            if (root->right->data < value) {
+                Node* child = root->right;
+                root->right = child->left;
+                child->left = root;
+                root = child;
+                if (root->right == nullptr) {
+                    break;
+                }
+            }
+            *left_max = root;
+            left_max = &root->right;
+            root = root->right;
+        } else {
+            break;
+        }
+    }
+    *left_max = root->left;
+    *right_min = root->right;
+    root->left = left_tree;
+    root->right = right_tree;
+    return root;
+}
+
+} // namespace bst
+
+/**
+* @brief Self-adjusting binary search tree with the BinarySearchTree interface.
+*
+* Every access splays the touched value to the root, so a few hot keys stay
+* within the first levels of the tree. Because contains() restructures the
+* tree, a SplayTree must not be read from several threads at once.
+*
+* Nodes come from @p Alloc, rebound to Node; the default std::allocator costs
+* no space. pmr::SplayTree takes a std::pmr::memory_resource.
+*/
+template <typename T, typename Alloc = std::allocator<T>>
+class SplayTree {
+public:
+    using Node = typename BinarySearchTree<T>::Node;
+    using allocator_type = Alloc;
+
+    /**
+    * @brief An empty SplayTree will be created.
+    */
+    SplayTree() : m_root(nullptr), m_size(0) {}
+
+    /**
+    * @brief An empty SplayTree whose nodes come from @p alloc.
+    */
+    explicit SplayTree(const Alloc& alloc) : m_root(nullptr), m_size(0), m_nodes(alloc) {}
+
+    /**
+    * @brief Constructor that initializes the tree with an array of values.
+    * @param arr Pointer to an array of values.
+    * @param size Size of the array.
+    */
+    SplayTree(const T* arr, int size) : SplayTree()
+    {
+        for (int i = 0; i < size; ++i) {
+            insert(arr[i]);
+        }
+    }
+
+    /**
+    * @brief Copy constructor for SplayTree. Copies the shape as well as the values.
+    * @param other Reference to SplayTree to copy from.
+    */
+    SplayTree(const SplayTree& other) : SplayTree(other, other.m_nodes.select_on_copy()) {}
+
+    /**
+    * @brief Copy constructor whose nodes come from @p alloc.
+    */
+    SplayTree(const SplayTree& other, const Alloc& alloc) : SplayTree(other, NodeAllocator(alloc)) {}
+
+    /**
+    * @brief Move constructor for SplayTree. The allocator moves along with the nodes.
+    * @param other R-value reference to another SplayTree object.
+    */
+    SplayTree(SplayTree&& other) noexcept
+    : m_root(other.m_root)
+    , m_size(other.m_size)
+    , m_nodes(other.m_nodes)
+    {
+        other.m_root = nullptr;
+        other.m_size = 0;
+    }
+
+    /**
+    * @brief Copy assignment. Builds the copy first, so on exception *this is unchanged.
+    * @param other Reference to SplayTree to copy from.
+    */
+    SplayTree& operator=(const SplayTree& other)
+    {
+        if (this != &other) {
+            using propagate = typename NodeAllocator::propagate_on_copy;
+            SplayTree copy(other, propagate::value ? other.m_nodes : m_nodes);
+            clear();
+            m_nodes.template propagate<propagate>(copy.m_nodes);
+            adopt(copy);
+        }
+        return *this;
+    }
+
+    /**
+    * @brief Move assignment. Takes over @p other's nodes when its allocator may
+    * free them; otherwise (e.g. two different pmr resources) moves the values
+    * into new nodes. @p other is left empty either way.
+    * @param other R-value reference to another SplayTree object.
+    */
+    SplayTree& operator=(SplayTree&& other) noexcept(NodeAllocator::adopts_on_move)
+    {
+        if (this == &other) {
+            return *this;
+        }
+        clear();
+        if constexpr (!NodeAllocator::adopts_on_move) {
+            if (!(m_nodes == other.m_nodes)) {
+                // Nothing is left half-built if a value's move throws.
+                try {
+                    clone(std::move(other));
+                } catch (...) {
+                    clear();
+                    throw;
+                }
+                other.clear();
+                return *this;
+            }
+        }
+        m_nodes.template propagate<typename NodeAllocator::propagate_on_move>(other.m_nodes);
+        adopt(other);
+        return *this;
+    }
+
+    /**
+    * @brief Exchanges the contents of two trees. Allocators are swapped if they
+    * propagate on swap; otherwise they must compare equal, as for std containers.
+    */
+    void swap(SplayTree& other) noexcept
+    {
+        std::swap(m_root, other.m_root);
+        std::swap(m_size, other.m_size);
+        m_nodes.swap(other.m_nodes);
+    }
+
+    friend void swap(SplayTree& a, SplayTree& b) noexcept
+    {
+        a.swap(b);
+    }
+
+    /**
+    * @brief Destructor for SplayTree.
+    */
+    ~SplayTree()
+    {
+        clear();
+    }
+
+    /**
+    * @brief Removes every value.
+    */
+    void clear()
+    {
+        // Same rotate-and-free walk as bst::destroy, through the allocator.
+        Node* root = m_root;
+        while (root != nullptr) {
+            if (root->left != nullptr) {
+                Node* left = root->left;
+                root->left = left->right;
+                left->right = root;
+                root = left;
+            } else {
+                Node* right = root->right;
+                m_nodes.destroy(root);
+                root = right;
+            }
+        }
+        m_root = nullptr;
+        m_size = 0;
+    }
+
+    /**
+    * @brief Inserts a value and splays it to the root.
+    * @param value The value to insert. Cannot be a duplicate.
+    * @return True if the value was inserted successfully, false if it already exists.
+    */
+    bool insert(T value)
+    {
+        if (m_root == nullptr) {
+            m_root = m_nodes.create(value);
+            ++m_size;
+            return true;
+        }
+        m_root = bst::splay(m_root, value);
+        if (!(value < m_root->data) && !(m_root->data < value)) {
+            return false;
+        }
+        Node* node = m_nodes.create(value);
+        if (value < m_root->data) {
+            node->left = m_root->left;
+            node->right = m_root;
+            m_root->left = nullptr;
+        } else {
+            node->right = m_root->right;
+            node->left = m_root;
+            m_root->right = nullptr;
+        }
+        m_root = node;
+        ++m_size;
+        return true;
+    }
+
+    /**
+    * @brief Removes a value from the tree.
+    * @param value The value to remove.
+    * @return True if the value was removed successfully, false if it was not found.
+    */
+    bool remove(T value)
+    {
+        m_root = bst::splay(m_root, value);
+        if (m_root == nullptr || value < m_root->data || m_root->data < value) {
+            return false;
+        }
+        Node* old = m_root;
+        if (old->left == nullptr) {
+            m_root = old->right;
+        } else {
+            // Every value on the left is smaller, so splaying brings up the maximum.
+            m_root = bst::splay(old->left, value);
+            m_root->right = old->right;
+        }
+        m_nodes.destroy(old);
+        --m_size;
+        return true;
+    }
+
+    /**
+    * @brief Checks if a value is contained in the tree, splaying it to the root.
+    * @param value The value to check.
+    * @return True if the value is found, false otherwise.
+    */
+    bool contains(T value) const
+    {
+        m_root = bst::splay(m_root, value);
+        return m_root != nullptr && !(value < m_root->data) && !(m_root->data < value);
+    }
+
+    /**
+    * @brief Returns the size of the tree.
+    * @return The number of nodes in the tree.
+    */
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+    * @brief Visits every value in ascending order. Unlike contains(), does not splay.
+    * @param visit Callable invoked as visit(const T&).
+    */
+    template <typename Visit>
+    void for_each(Visit&& visit) const
+    {
+        bst::for_each(m_root, visit);
+    }
+
+    /**
+    * @brief Returns a copy of the allocator the tree was built with.
+    */
+    allocator_type get_allocator() const
+    {
+        return allocator_type(m_nodes.get());
+    }
+
+    /**
+    * @brief Checks if two trees hold the same values, regardless of shape.
+    * @param other The other tree to compare with.
+    * @return True if the trees are equal, false otherwise.
+    */
+    bool operator==(const SplayTree& other) const
+    {
+        if (m_size != other.m_size) {
+            return false;
+        }
+        std::vector<const Node*> lhs;
+        std::vector<const Node*> rhs;
+        const Node* a = m_root;
+        const Node* b = other.m_root;
+        while (a != nullptr || !lhs.empty()) {
+            for (; a != nullptr; a = a->left) {
+                lhs.push_back(a);
+            }
+            for (; b != nullptr; b = b->left) {
+                rhs.push_back(b);
+            }
+            a = lhs.back();
+            b = rhs.back();
+            lhs.pop_back();
+            rhs.pop_back();
+            if (a->data < b->data || b->data < a->data) {
+                return false;
+            }
+            a = a->right;
+            b = b->right;
+        }
+        return true;
+    }
+
+    /**
+    * @brief Checks if the tree is not equal to another tree.
+    * @param other The other tree to compare with.
+    * @return True if the trees are not equal, false otherwise.
+    */
+    bool operator!=(const SplayTree& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    using NodeAllocator = policy::NodeAllocator<Node, Alloc>;
+
+    SplayTree(const SplayTree& other, const NodeAllocator& nodes) : m_root(nullptr), m_size(0), m_nodes(nodes)
+    {
+        try {
+            clone(other);
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    /**
+    * @brief Builds a copy of @p other's shape in this empty tree, moving the values if @p other is an rvalue.
+    */
+    template <typename Other>
+    void clone(Other&& other)
+    {
+        constexpr bool move = !std::is_lvalue_reference_v<Other>;
+        auto make = [&](Node* src) {
+            if constexpr (move) {
+                return m_nodes.create(std::move(src->data));
+            } else {
+                return m_nodes.create(static_cast<const T&>(src->data));
+            }
+        };
+        if (other.m_root == nullptr) {
+            return;
+        }
+        m_root = make(other.m_root);
+        std::vector<std::pair<Node*, Node*>> pending{{other.m_root, m_root}};
+        while (!pending.empty()) {
+            auto [src, dst] = pending.back();
+            pending.pop_back();
+            if (src->left != nullptr) {
+                dst->left = make(src->left);
+                pending.push_back({src->left, dst->left});
+            }
+            if (src->right != nullptr) {
+                dst->right = make(src->right);
+                pending.push_back({src->right, dst->right});
+            }
+        }
+        m_size = other.m_size;
+    }
+
+    /**
+    * @brief Takes over @p other's nodes. This tree must be empty and able to free them.
+    */
+    void adopt(SplayTree& other) noexcept
+    {
+        m_root = other.m_root;
+        m_size = other.m_size;
+        other.m_root = nullptr;
+        other.m_size = 0;
+    }
+
+    mutable Node* m_root; ///< Rewritten by every access, including const lookups.
+    size_t m_size;
+    [[no_unique_address]] NodeAllocator m_nodes;
+};
+
+namespace policy {
+
+// contains() splays, so a SplayTree cannot be shared by concurrent readers.
+template <typename T, typename Alloc>
+struct mutating_reads<SplayTree<T, Alloc>> : std::true_type {};
+
+} // namespace policy
+
+namespace pmr {
+
+/**
+* @brief SplayTree whose nodes come from a std::pmr::memory_resource, e.g. a NodePool or MonotonicArena.
+*/
+template <typename T>
+using SplayTree = cppclass::SplayTree<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace cppclass
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef> // for size_t
+#include <utility> // for std::pair
+#include <vector>
+
+#include "hw09_join.h"
+
+namespace cppclass {
+namespace bst {
+
+/**
+* @brief Structural facts gathered by verify().
+*/
+struct Verification {
+    size_t count = 0;          ///< Number of nodes reached.
+    size_t height = 0;         ///< Nodes on the longest root-to-leaf path.
+    bool ordered = true;       ///< Every value lies strictly between its ancestors' bounds.
+    bool heap_ordered = true;  ///< No child has a higher bst::priority than its parent.
+
+    /**
+    * @brief Combines the facts of two sibling subtrees below one parent.
+    */
+    static Verification merge(const Verification& left, const Verification& right)
+    {
+        Verification out;
+        out.count = left.count + right.count + 1;
+        out.height = (left.height > right.height ? left.height : right.height) + 1;
+        out.ordered = left.ordered && right.ordered;
+        out.heap_ordered = left.heap_ordered && right.heap_ordered;
+        return out;
+    }
+};
+
+namespace detail {
+
+// Iterative check of one subtree, so degenerate trees cannot overflow the stack.
+template <typename Node, typename T>
+Verification verify_serial(const Node* root, const T* low, const T* high)
+{
+    Verification out;
+    struct Frame {
+        const Node* node;
+        const T* low;
+        const T* high;
+        size_t depth;
+    };
+    std::vector<Frame> stack;
+    if (root != nullptr) {
+        stack.push_back({root, low, high, 1});
+    }
+    while (!stack.empty()) {
+        Frame f = stack.back();
+        stack.pop_back();
+        const Node* n = f.node;
+        ++out.count;
+        out.height = f.depth > out.height ? f.depth : out.height;
+        if ((f.low != nullptr && !(*f.low < n->data)) || (f.high != nullptr && !(n->data < *f.high))) {
+            out.ordered = false;
+        }
+        for (const Node* child : {n->left, n->right}) {
+            if (child != nullptr && priority(n->data) < priority(child->data)) {
+                out.heap_ordered = false;
+            }
+        }
+        if (n->left != nullptr) {
+            stack.push_back({n->left, f.low, &n->data, f.depth + 1});
+        }
+        if (n->right != nullptr) {
+            stack.push_back({n->right, &n->data, f.high, f.depth + 1});
+        }
+    }
+    return out;
+}
+
+template <typename Node, typename T>
+Verification verify_parallel(const Node* root, const T* low, const T* high, unsigned depth)
+{
+    if (root == nullptr || depth == 0) {
+        return verify_serial(root, low, high);
+    }
+    auto [left, right] = fork_join(depth,
+        [=] { return verify_parallel(root->left, low, &root->data, depth - 1); },
+        [=] { return verify_parallel(root->right, &root->data, high, depth - 1); });
+    Verification out = Verification::merge(left, right);
+    if ((low != nullptr && !(*low < root->data)) || (high != nullptr && !(root->data < *high))) {
+        out.ordered = false;
+    }
+    for (const Node* child : {root->left, root->right}) {
+        if (child != nullptr && priority(root->data) < priority(child->data)) {
+            out.heap_ordered = false;
+        }
+    }
+    return out;
+}
+
+} // namespace detail
+
+/**
+* @brief Checks the ordering of a subtree and gathers its size and height.
+*
+* Each node is checked against the (low, high) bounds inherited from its
+* ancestors, so the check is O(n) and needs no in-order pass. The top
+* @p fork_depth levels are split into parallel tasks; below that every task
+* walks its subtree iteratively.
+*
+* @param root The subtree to check. May be nullptr.
+* @param fork_depth Number of levels that fork tasks.
+* @return What was found. heap_ordered only matters for trees built through
+*         join/split (hashed treaps); other trees will usually fail it.
+*/
+template <typename Node>
+Verification verify(const Node* root, unsigned fork_depth = default_fork_depth())
+{
+    using T = decltype(root->data);
+    return detail::verify_parallel<Node, T>(root, nullptr, nullptr, fork_depth);
+}
+
+} // namespace bst
+
+} // namespace cppclass
@@ -0,0 +1,321 @@
+#include "thread_pool.h"
+
+#include <cstdlib> // for getenv, strtol
+
+#if defined(__linux__)
+#include <sched.h> // for sched_getaffinity
+#endif
+
+namespace cppclass {
+namespace runtime {
+
+namespace {
+
+// The pool and deque index of the worker running on this thread, if any.
+thread_local const ThreadPool* t_pool = nullptr;
+thread_local unsigned t_index = 0;
+
+// Tries each idle loop makes before a worker goes to sleep.
+constexpr int spins_before_sleep = 64;
+
+uint64_t next_random(uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+} // namespace
+
+WorkStealingDeque::Ring::Ring(size_t capacity)
+: mask(capacity - 1)
+, slots(new std::atomic<Task*>[capacity])
+{}
+
+WorkStealingDeque::WorkStealingDeque(size_t capacity)
+: m_top(0)
+, m_bottom(0)
+{
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    m_rings.push_back(std::make_unique<Ring>(rounded));
+    m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::~WorkStealingDeque() = default;
+
+WorkStealingDeque::Ring* WorkStealingDeque::grow(Ring* ring, int64_t top, int64_t bottom)
+{
+    auto bigger = std::make_unique<Ring>(2 * (ring->mask + 1));
+    for (int64_t i = top; i < bottom; ++i) {
+        bigger->put(i, ring->get(i));
+    }
+    Ring* raw = bigger.get();
+    m_rings.push_back(std::move(bigger));
+    m_ring.store(raw, std::memory_order_release);
+    return raw;
+}
+
+void WorkStealingDeque::push(Task* task)
+{
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    int64_t top = m_top.load(std::memory_order_acquire);
+    Ring* ring = m_ring.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(ring->mask)) {
+        ring = grow(ring, top, bottom);
+    }
+    ring->put(bottom, task);
+    // A release store rather than the paper's fence plus relaxed store: the
+    // same code on x86, and visible to ThreadSanitizer, which ignores fences.
+    m_bottom.store(bottom + 1, std::memory_order_release);
+}
+
+Task* WorkStealingDeque::pop()
+{
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    Ring* ring = m_ring.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Task* task = ring->get(bottom);
+    if (top == bottom) {
+        // Last task: race the thieves for it.
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            task = nullptr;
+        }
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+Task* WorkStealingDeque::steal()
+{
+    int64_t top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = m_bottom.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return nullptr;
+    }
+    Ring* ring = m_ring.load(std::memory_order_acquire);
+    Task* task = ring->get(top);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return task;
+}
+
+bool WorkStealingDeque::empty() const
+{
+    return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+}
+
+ThreadPool::ThreadPool(unsigned workers)
+{
+    if (workers == 0) {
+        workers = 1;
+    }
+    // Every deque exists before any thread starts, so thieves never see a partial vector.
+    for (unsigned i = 0; i < workers; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < workers; ++i) {
+        m_workers[i]->thread = std::thread([this, i] { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop.store(true);
+        m_epoch.fetch_add(1);
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        worker->thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+unsigned ThreadPool::default_workers()
+{
+    if (const char* text = std::getenv("CPPCLASS_THREADS")) {
+        long requested = std::strtol(text, nullptr, 10);
+        if (requested > 0) {
+            return static_cast<unsigned>(requested);
+        }
+    }
+#if defined(__linux__)
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof set, &set) == 0 && CPU_COUNT(&set) > 0) {
+        return static_cast<unsigned>(CPU_COUNT(&set));
+    }
+#endif
+    unsigned threads = std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+bool ThreadPool::on_worker() const
+{
+    return t_pool == this;
+}
+
+void ThreadPool::spawn(Task* task)
+{
+    m_workers[t_index]->deque.push(task);
+    // Pairs with the increment in worker_loop: either a sleeper is counted
+    // here or its last look for work finds this task.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed) > 0) {
+        wake_one();
+    }
+}
+
+void ThreadPool::wake_one()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_epoch.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_wake.notify_one();
+}
+
+void ThreadPool::wait(Task& task)
+{
+    uint64_t seed = 0x9e3779b97f4a7c15ULL * (t_index + 1);
+    WorkStealingDeque& own = m_workers[t_index]->deque;
+    while (!task.done()) {
+        // Anything above task on our deque was pushed and joined by callees,
+        // so the next pop is task itself unless a thief took it.
+        Task* next = own.pop();
+        if (next == nullptr) {
+            next = steal_from_others(t_index, seed);
+        }
+        if (next != nullptr) {
+            next->execute();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::submit(Task& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_injected.push_back(&task);
+        m_injected_count.fetch_add(1);
+        m_epoch.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_wake.notify_one();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [&] { return task.done(); });
+}
+
+Task* ThreadPool::take_injected()
+{
+    if (m_injected_count.load() == 0) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_injected.empty()) {
+        return nullptr;
+    }
+    Task* task = m_injected.front();
+    m_injected.pop_front();
+    m_injected_count.fetch_sub(1);
+    return task;
+}
+
+Task* ThreadPool::steal_from_others(unsigned self, uint64_t& seed)
+{
+    size_t count = m_workers.size();
+    if (count < 2) {
+        return nullptr;
+    }
+    // Start at a random victim so thieves spread out, then try everyone once.
+    size_t start = static_cast<size_t>(next_random(seed) % count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t victim = (start + i) % count;
+        if (victim == self) {
+            continue;
+        }
+        if (Task* task = m_workers[victim]->deque.steal()) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+bool ThreadPool::work_visible() const
+{
+    if (m_injected_count.load() > 0) {
+        return true;
+    }
+    for (const auto& worker : m_workers) {
+        if (!worker->deque.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::worker_loop(unsigned index)
+{
+    t_pool = this;
+    t_index = index;
+    uint64_t seed = 0x9e3779b97f4a7c15ULL * (index + 1);
+    int idle = 0;
+
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        Task* task = m_workers[index]->deque.pop();
+        if (task == nullptr) {
+            if (Task* job = take_injected()) {
+                job->execute();
+                // The submitter may destroy job as soon as it sees done(); the
+                // lock keeps it from missing this wakeup.
+                { std::lock_guard<std::mutex> lock(m_mutex); }
+                m_done.notify_all();
+                idle = 0;
+                continue;
+            }
+            task = steal_from_others(index, seed);
+        }
+        if (task != nullptr) {
+            task->execute();
+            idle = 0;
+            continue;
+        }
+        if (++idle < spins_before_sleep) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        m_sleeping.fetch_add(1);
+        uint64_t epoch = m_epoch.load();
+        if (!work_visible()) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop.load() || m_epoch.load(std::memory_order_relaxed) != epoch; });
+        }
+        m_sleeping.fetch_sub(1);
+        idle = 0;
+    }
+    t_pool = nullptr;
+}
+
+} // namespace runtime
+} // namespace cppclass
@@ -0,0 +1,378 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>   // for size_t
+#include <cstdint>   // for int64_t
+#include <deque>
+#include <exception> // for std::exception_ptr
+#include <memory>    // for std::unique_ptr
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>   // for std::forward
+#include <vector>
+
+namespace cppclass {
+namespace runtime {
+
+/**
+* @brief A unit of work run by the pool. Knows when it has finished and what it threw.
+*/
+class Task {
+public:
+    virtual ~Task() = default;
+
+    /**
+    * @brief Runs the task once, capturing any exception for rethrow().
+    */
+    void execute() noexcept
+    {
+        try {
+            run();
+        } catch (...) {
+            m_error = std::current_exception();
+        }
+        m_done.store(true, std::memory_order_release);
+    }
+
+    bool done() const
+    {
+        return m_done.load(std::memory_order_acquire);
+    }
+
+    /**
+    * @brief Rethrows the exception the task ended with, if any. Call after done().
+    */
+    void rethrow() const
+    {
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+protected:
+    virtual void run() = 0;
+
+private:
+    std::atomic<bool> m_done{false};
+    std::exception_ptr m_error;
+};
+
+/**
+* @brief Task that calls a callable. The callable, often a lambda on the stack, must outlive it.
+*/
+template <typename Function>
+class FunctionTask : public Task {
+public:
+    explicit FunctionTask(Function& function) : m_function(function) {}
+
+protected:
+    void run() override
+    {
+        m_function();
+    }
+
+private:
+    Function& m_function;
+};
+
+/**
+* @brief Chase–Lev work-stealing deque of Task pointers.
+*
+* The owning worker pushes and pops at the bottom without locking; other
+* workers steal from the top with one compare-and-swap. Memory orders follow
+* Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models"
+* (PPoPP 2013). The ring doubles when full; replaced rings are kept until the
+* deque dies because a thief may still be reading one.
+*/
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(size_t capacity = 256);
+    ~WorkStealingDeque();
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+    * @brief Adds a task at the bottom. Owner thread only.
+    */
+    void push(Task* task);
+
+    /**
+    * @brief Takes the most recently pushed task. Owner thread only.
+    * @return The task, or nullptr if the deque is empty or a thief won the last one.
+    */
+    Task* pop();
+
+    /**
+    * @brief Takes the oldest task. Any thread.
+    * @return The task, or nullptr if the deque is empty or another thread got there first.
+    */
+    Task* steal();
+
+    /**
+    * @brief A racy emptiness check, good enough to decide whether to go to sleep.
+    */
+    bool empty() const;
+
+private:
+    struct Ring {
+        explicit Ring(size_t capacity);
+
+        Task* get(int64_t index) const
+        {
+            return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, Task* task)
+        {
+            slots[static_cast<size_t>(index) & mask].store(task, std::memory_order_relaxed);
+        }
+
+        size_t mask;
+        std::unique_ptr<std::atomic<Task*>[]> slots;
+    };
+
+    Ring* grow(Ring* ring, int64_t top, int64_t bottom);
+
+    alignas(64) std::atomic<int64_t> m_top;
+    alignas(64) std::atomic<int64_t> m_bottom;
+    std::atomic<Ring*> m_ring;
+    std::vector<std::unique_ptr<Ring>> m_rings; ///< Current ring last; owner thread only.
+};
+
+/**
+* @brief Fixed set of worker threads, one work-stealing deque each, running fork-join work.
+*
+* A worker that forks pushes the task on its own deque and goes on with the
+* other half; idle workers steal the oldest (largest) pending task from a
+* random victim. A thread outside the pool that starts parallel work hands the
+* whole job to the workers and blocks until it is done, so the number of busy
+* threads never exceeds size() however deeply calls nest or however many
+* threads call in. Idle workers sleep on a condition variable.
+*
+* Libraries should use global() rather than creating pools of their own.
+*/
+class ThreadPool {
+public:
+    /**
+    * @brief Starts @p workers threads (at least one).
+    */
+    explicit ThreadPool(unsigned workers = default_workers());
+
+    /**
+    * @brief Stops the workers. No parallel call may still be running.
+    */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+    * @brief The process-wide pool, started on first use with default_workers() threads.
+    */
+    static ThreadPool& global();
+
+    /**
+    * @brief Worker count for the global pool.
+    * @return CPPCLASS_THREADS if set to a positive number, else the number of
+    *         CPUs this process may run on (its affinity mask, so taskset and
+    *         container CPU sets are honoured).
+    */
+    static unsigned default_workers();
+
+    /**
+    * @brief Number of worker threads.
+    */
+    unsigned size() const
+    {
+        return static_cast<unsigned>(m_workers.size());
+    }
+
+    /**
+    * @brief True when called from one of this pool's workers.
+    */
+    bool on_worker() const;
+
+    /**
+    * @brief Runs @p first and @p second, possibly in parallel, and returns when both are done.
+    *
+    * @p first is offered to thieves while the calling worker runs @p second.
+    * If either throws, the exception is rethrown here after both have finished.
+    */
+    template <typename First, typename Second>
+    void invoke(First&& first, Second&& second)
+    {
+        if (!on_worker()) {
+            auto job = [&] { invoke(first, second); };
+            run_external(job);
+            return;
+        }
+        FunctionTask<std::remove_reference_t<First>> forked(first);
+        spawn(&forked);
+        try {
+            second();
+        } catch (...) {
+            // forked refers to this frame, so it must finish before unwinding.
+            wait(forked);
+            throw;
+        }
+        wait(forked);
+        forked.rethrow();
+    }
+
+    /**
+    * @brief Calls body(lo, hi) on disjoint subranges that together cover [begin, end).
+    *
+    * The range is halved recursively until a piece holds at most @p grain
+    * indices.
+    *
+    * @param grain Largest range handed to one call of @p body; 0 picks one
+    *              that gives each worker about eight pieces.
+    */
+    template <typename Body>
+    void parallel_for(size_t begin, size_t end, Body&& body, size_t grain = 0)
+    {
+        if (begin >= end) {
+            return;
+        }
+        grain = grain_for(end - begin, grain);
+        if (end - begin <= grain) {
+            body(begin, end);
+            return;
+        }
+        split_for(begin, end, grain, body);
+    }
+
+    /**
+    * @brief Reduces map(lo, hi) over subranges of [begin, end) with @p combine.
+    *
+    * Pieces are combined in index order, so @p combine need only be associative.
+    *
+    * @param identity Result for an empty range.
+    * @param map Called as map(lo, hi) and returns a T for that piece.
+    * @param combine Called as combine(T, T).
+    * @param grain As for parallel_for().
+    */
+    template <typename T, typename Map, typename Combine>
+    T parallel_reduce(size_t begin, size_t end, T identity, Map&& map, Combine&& combine, size_t grain = 0)
+    {
+        if (begin >= end) {
+            return identity;
+        }
+        return split_reduce<T>(begin, end, grain_for(end - begin, grain), map, combine);
+    }
+
+private:
+    struct Worker {
+        WorkStealingDeque deque;
+        std::thread thread;
+    };
+
+    size_t grain_for(size_t count, size_t grain) const
+    {
+        if (grain > 0) {
+            return grain;
+        }
+        size_t pieces = size_t{8} * size();
+        return count / pieces > 0 ? count / pieces : 1;
+    }
+
+    template <typename Body>
+    void split_for(size_t begin, size_t end, size_t grain, Body& body)
+    {
+        if (end - begin <= grain) {
+            body(begin, end);
+            return;
+        }
+        size_t mid = begin + (end - begin) / 2;
+        invoke([&] { split_for(begin, mid, grain, body); },
+               [&] { split_for(mid, end, grain, body); });
+    }
+
+    template <typename T, typename Map, typename Combine>
+    T split_reduce(size_t begin, size_t end, size_t grain, Map& map, Combine& combine)
+    {
+        if (end - begin <= grain) {
+            return map(begin, end);
+        }
+        size_t mid = begin + (end - begin) / 2;
+        std::optional<T> left;
+        std::optional<T> right;
+        invoke([&] { left.emplace(split_reduce<T>(begin, mid, grain, map, combine)); },
+               [&] { right.emplace(split_reduce<T>(mid, end, grain, map, combine)); });
+        return combine(std::move(*left), std::move(*right));
+    }
+
+    /**
+    * @brief Pushes a task on the calling worker's deque and wakes a sleeper.
+    */
+    void spawn(Task* task);
+
+    /**
+    * @brief Runs other tasks on the calling worker until @p task is done.
+    */
+    void wait(Task& task);
+
+    /**
+    * @brief From a thread outside the pool: runs @p job on a worker and blocks until it returns.
+    */
+    template <typename Job>
+    void run_external(Job& job)
+    {
+        FunctionTask<Job> task(job);
+        submit(task);
+        task.rethrow();
+    }
+
+    void submit(Task& task);
+    Task* steal_from_others(unsigned self, uint64_t& seed);
+    Task* take_injected();
+    bool work_visible() const;
+    void worker_loop(unsigned index);
+    void wake_one();
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    std::mutex m_mutex;             ///< Guards m_injected and changes to m_epoch.
+    std::condition_variable m_wake; ///< Idle workers wait here.
+    std::condition_variable m_done; ///< External callers wait here.
+    std::deque<Task*> m_injected;   ///< Jobs from threads outside the pool.
+    std::atomic<size_t> m_injected_count{0};
+    std::atomic<uint64_t> m_epoch{0}; ///< Bumped whenever work appears.
+    std::atomic<unsigned> m_sleeping{0};
+    std::atomic<bool> m_stop{false};
+};
+
+/**
+* @brief ThreadPool::global().invoke(first, second).
+*/
+template <typename First, typename Second>
+void invoke(First&& first, Second&& second)
+{
+    ThreadPool::global().invoke(std::forward<First>(first), std::forward<Second>(second));
+}
+
+/**
+* @brief ThreadPool::global().parallel_for(begin, end, body, grain).
+*/
+template <typename Body>
+void parallel_for(size_t begin, size_t end, Body&& body, size_t grain = 0)
+{
+    ThreadPool::global().parallel_for(begin, end, std::forward<Body>(body), grain);
+}
+
+/**
+* @brief ThreadPool::global().parallel_reduce(begin, end, identity, map, combine, grain).
+*/
+template <typename T, typename Map, typename Combine>
+T parallel_reduce(size_t begin, size_t end, T identity, Map&& map, Combine&& combine, size_t grain = 0)
+{
+    return ThreadPool::global().parallel_reduce(begin, end, std::move(identity), std::forward<Map>(map),
+                                                std::forward<Combine>(combine), grain);
+}
+
+} // namespace runtime
+} // namespace cppclass
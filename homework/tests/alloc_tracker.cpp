@@ -0,0 +1,292 @@
+// Replaces the global allocation functions for the test binary so that
+// AllocationScope can see heap traffic. Every block carries a small header
+// holding its size, so deletes can be attributed bytes even when the
+// unsized operator delete is used. Over-aligned types (alignas above
+// alignof(std::max_align_t)) go through the std::align_val_t overloads,
+// which pad the header out to the requested alignment.
+
+#include "alloc_tracker.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+
+namespace cppclass
+{
+namespace alloc
+{
+namespace
+{
+    // Keeps the returned pointer aligned for any fundamental type.
+    constexpr size_t header_size = alignof(std::max_align_t);
+
+    thread_local AllocationScope* current = nullptr;
+
+    // Space in front of the returned pointer; a multiple of the alignment, so the pointer keeps it.
+    size_t offset_for(size_t alignment)
+    {
+        return alignment > header_size ? alignment : header_size;
+    }
+
+    void* allocate(size_t size, const void* caller, size_t alignment = header_size)
+    {
+        size_t offset = offset_for(alignment);
+        if (size > SIZE_MAX - offset) {
+            throw std::bad_alloc();
+        }
+        void* block;
+        for (;;) {
+            if (alignment <= header_size) {
+                block = std::malloc(offset + size);
+            } else if (posix_memalign(&block, alignment, offset + size) != 0) {
+                block = nullptr;
+            }
+            if (block != nullptr) {
+                break;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+        char* ptr = static_cast<char*>(block) + offset;
+        // The size sits right below the pointer whatever the alignment.
+        *reinterpret_cast<size_t*>(ptr - header_size) = size;
+        for (AllocationScope* scope = current; scope != nullptr; scope = scope->parent()) {
+            scope->record_allocation(caller, size);
+        }
+        return ptr;
+    }
+
+    void deallocate(void* ptr, size_t alignment = header_size)
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+        size_t size = *reinterpret_cast<size_t*>(static_cast<char*>(ptr) - header_size);
+        for (AllocationScope* scope = current; scope != nullptr; scope = scope->parent()) {
+            scope->record_deallocation(size);
+        }
+        std::free(static_cast<char*>(ptr) - offset_for(alignment));
+    }
+
+    // Suspends tracking on this thread while report() itself allocates.
+    struct Pause {
+        AllocationScope* saved = current;
+
+        Pause()
+        {
+            current = nullptr;
+        }
+
+        ~Pause()
+        {
+            current = saved;
+        }
+    };
+} // namespace
+
+AllocationScope::AllocationScope()
+: m_parent(current)
+, m_stats()
+, m_sites()
+, m_other_allocations(0)
+{
+    current = this;
+}
+
+AllocationScope::~AllocationScope()
+{
+    current = m_parent;
+}
+
+void AllocationScope::record_allocation(const void* caller, size_t size)
+{
+    ++m_stats.allocations;
+    m_stats.bytes += size;
+    m_stats.live_bytes += static_cast<int64_t>(size);
+    if (m_stats.live_bytes > m_stats.peak_bytes) {
+        m_stats.peak_bytes = m_stats.live_bytes;
+    }
+
+    // Open addressing on the caller address; no allocation allowed in here.
+    size_t slot = (reinterpret_cast<uintptr_t>(caller) >> 4) % site_slots;
+    for (size_t probe = 0; probe < site_slots; ++probe, slot = (slot + 1) % site_slots) {
+        Site& site = m_sites[slot];
+        if (site.caller == nullptr) {
+            site.caller = caller;
+        }
+        if (site.caller == caller) {
+            ++site.allocations;
+            site.bytes += size;
+            return;
+        }
+    }
+    ++m_other_allocations;
+}
+
+void AllocationScope::record_deallocation(size_t size)
+{
+    ++m_stats.deallocations;
+    m_stats.live_bytes -= static_cast<int64_t>(size);
+}
+
+void AllocationScope::report(std::ostream& out, size_t top) const
+{
+    Pause pause;
+    out << m_stats.allocations << " allocation(s), " << m_stats.bytes << " byte(s), "
+        << m_stats.deallocations << " deallocation(s), peak " << m_stats.peak_bytes << " live byte(s)\n";
+
+    std::vector<Site> sites;
+    for (const Site& site : m_sites) {
+        if (site.caller != nullptr) {
+            sites.push_back(site);
+        }
+    }
+    std::sort(sites.begin(), sites.end(), [](const Site& a, const Site& b) { return a.allocations > b.allocations; });
+    if (sites.size() > top) {
+        sites.resize(top);
+    }
+    for (const Site& site : sites) {
+        out << "  " << site.allocations << " x, " << site.bytes << " B at ";
+        Dl_info info;
+        if (dladdr(site.caller, &info) != 0 && info.dli_sname != nullptr) {
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            out << (status == 0 ? demangled : info.dli_sname) << "+"
+                << static_cast<const char*>(site.caller) - static_cast<const char*>(info.dli_saddr);
+            std::free(demangled);
+        } else {
+            out << site.caller;
+        }
+        out << "\n";
+    }
+    if (m_other_allocations > 0) {
+        out << "  " << m_other_allocations << " x at other call sites\n";
+    }
+}
+
+} // namespace alloc
+} // namespace cppclass
+
+void* operator new(std::size_t size)
+{
+    return cppclass::alloc::allocate(size, __builtin_return_address(0));
+}
+
+void* operator new[](std::size_t size)
+{
+    return cppclass::alloc::allocate(size, __builtin_return_address(0));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return cppclass::alloc::allocate(size, __builtin_return_address(0));
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return cppclass::alloc::allocate(size, __builtin_return_address(0));
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr) noexcept
+{
+    cppclass::alloc::deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    cppclass::alloc::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    cppclass::alloc::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    cppclass::alloc::deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    cppclass::alloc::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    cppclass::alloc::deallocate(ptr);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return cppclass::alloc::allocate(size, __builtin_return_address(0), static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return cppclass::alloc::allocate(size, __builtin_return_address(0), static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try {
+        return cppclass::alloc::allocate(size, __builtin_return_address(0), static_cast<std::size_t>(alignment));
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try {
+        return cppclass::alloc::allocate(size, __builtin_return_address(0), static_cast<std::size_t>(alignment));
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept
+{
+    cppclass::alloc::deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept
+{
+    cppclass::alloc::deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+    cppclass::alloc::deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+    cppclass::alloc::deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    cppclass::alloc::deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    cppclass::alloc::deallocate(ptr, static_cast<std::size_t>(alignment));
+}
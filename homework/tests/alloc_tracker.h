@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace cppclass
+{
+namespace alloc
+{
+    /**
+    * @brief Heap traffic seen by an AllocationScope.
+    */
+    struct AllocationStats {
+        size_t allocations = 0;    ///< Calls to operator new / new[].
+        size_t deallocations = 0;  ///< Calls to operator delete / delete[] with a non-null pointer.
+        size_t bytes = 0;          ///< Bytes requested by those allocations.
+        int64_t live_bytes = 0;    ///< Bytes allocated minus bytes freed; negative if older blocks were freed.
+        int64_t peak_bytes = 0;    ///< Highest live_bytes reached.
+    };
+
+    /**
+    * @brief Counts the global operator new / delete calls made by this thread while it is alive.
+    *
+    * Only builds that link alloc_tracker.cpp (the test binary) replace the
+    * global allocation functions; everywhere else there is no cost. Scopes
+    * nest, and every enclosing scope on the thread sees each allocation.
+    * Allocations are also grouped by call site, the return address of
+    * operator new, for report().
+    */
+    class AllocationScope {
+    public:
+        AllocationScope();
+        ~AllocationScope();
+
+        AllocationScope(const AllocationScope&) = delete;
+        AllocationScope& operator=(const AllocationScope&) = delete;
+
+        const AllocationStats& stats() const
+        {
+            return m_stats;
+        }
+
+        /**
+        * @brief Writes the totals and the @p top call sites by allocation count.
+        */
+        void report(std::ostream& out, size_t top = 10) const;
+
+        /// @cond internal
+        struct Site {
+            const void* caller;
+            size_t allocations;
+            size_t bytes;
+        };
+        static constexpr size_t site_slots = 64;
+
+        void record_allocation(const void* caller, size_t size);
+        void record_deallocation(size_t size);
+
+        AllocationScope* parent() const
+        {
+            return m_parent;
+        }
+        /// @endcond
+
+    private:
+        AllocationScope* m_parent;
+        AllocationStats m_stats;
+        Site m_sites[site_slots];
+        size_t m_other_allocations; ///< Allocations whose call site did not fit in m_sites.
+    };
+
+    /**
+    * @brief Runs @p operation and checks it made at most @p budget allocations.
+    *
+    * Use as EXPECT_TRUE(AllocatesAtMost(1, [&] { list.append(3); })); a
+    * failure message carries the stats and call sites.
+    */
+    template <typename Operation>
+    ::testing::AssertionResult AllocatesAtMost(size_t budget, Operation&& operation)
+    {
+        std::ostringstream details;
+        AllocationStats stats;
+        {
+            AllocationScope scope;
+            std::forward<Operation>(operation)();
+            stats = scope.stats();
+            if (stats.allocations > budget) {
+                scope.report(details);
+            }
+        }
+        if (stats.allocations <= budget) {
+            return ::testing::AssertionSuccess();
+        }
+        return ::testing::AssertionFailure() << "expected at most " << budget << " allocation(s), got "
+                                             << stats.allocations << "\n" << details.str();
+    }
+
+} // namespace alloc
+} // namespace cppclass
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "hw09.h"
+
+namespace cppclass
+{
+    /**
+    * @brief Owns a BinarySearchTree without calling its constructors or destructor.
+    *
+    * Those are the exercise and stay undefined, so the members built on the
+    * bst:: functions (set operations, insert_hint, remove_if, ...) are tested
+    * on trees made here: the nodes are linked with bst::insert and freed with
+    * bst::destroy. The tree lives in a union, so its own destructor never runs.
+    */
+    template <typename T>
+    class BinarySearchTreeHarness {
+    public:
+        using Tree = BinarySearchTree<T>;
+
+        BinarySearchTreeHarness() : m_tree(static_cast<typename Tree::Node*>(nullptr), 0) {}
+
+        /**
+        * @brief Builds a hashed treap of @p values. Duplicates are skipped.
+        */
+        explicit BinarySearchTreeHarness(const std::vector<T>& values) : m_tree(build(values)) {}
+
+        /**
+        * @brief Adopts @p size linked nodes, in whatever shape they are.
+        */
+        BinarySearchTreeHarness(typename Tree::Node* root, size_t size) : m_tree(root, size) {}
+
+        /**
+        * @brief Holds the tree returned by @p make(), e.g. a set operation.
+        */
+        template <typename Make>
+        explicit BinarySearchTreeHarness(Make make) : m_tree(make())
+        {
+        }
+
+        ~BinarySearchTreeHarness()
+        {
+            bst::destroy(m_tree.m_root);
+        }
+
+        BinarySearchTreeHarness(const BinarySearchTreeHarness&) = delete;
+        BinarySearchTreeHarness& operator=(const BinarySearchTreeHarness&) = delete;
+
+        Tree& tree()
+        {
+            return m_tree;
+        }
+
+        /**
+        * @brief The tree's recorded size; verify() checks it against the nodes.
+        */
+        size_t size() const
+        {
+            return m_tree.m_size;
+        }
+
+        /**
+        * @brief Removes @p value the way an exercise remove() may: bst::erase, no new version.
+        */
+        bool remove(const T& value)
+        {
+            if (!bst::erase(m_tree.m_root, value)) {
+                return false;
+            }
+            --m_tree.m_size;
+            return true;
+        }
+
+        std::vector<T> values() const
+        {
+            std::vector<T> out;
+            m_tree.for_each([&](const T& v) { out.push_back(v); });
+            return out;
+        }
+
+    private:
+        static Tree build(const std::vector<T>& values)
+        {
+            typename Tree::Node* root = nullptr;
+            size_t size = 0;
+            for (const T& v : values) {
+                auto* node = new typename Tree::Node(v);
+                if (bst::insert(root, node)) {
+                    ++size;
+                } else {
+                    delete node;
+                }
+            }
+            return Tree(root, size);
+        }
+
+        union {
+            Tree m_tree;
+        };
+    };
+}
@@ -0,0 +1,152 @@
+#include "alloc_tracker.h"
+#include "hw07.h"
+#include "hw09_bloom.h"
+#include "hw09_compact.h"
+#include "hw09_splay.h"
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <vector>
+
+namespace cppclass
+{
+namespace alloc
+{
+    TEST(AllocTracker, CountsAndBytes)
+    {
+        AllocationScope scope;
+        {
+            std::vector<int> values;
+            values.reserve(10);
+            auto single = std::make_unique<long>(7);
+            EXPECT_EQ(scope.stats().allocations, 2);
+            EXPECT_EQ(scope.stats().bytes, 10 * sizeof(int) + sizeof(long));
+            EXPECT_EQ(scope.stats().live_bytes, static_cast<int64_t>(10 * sizeof(int) + sizeof(long)));
+        }
+        EXPECT_EQ(scope.stats().deallocations, 2);
+        EXPECT_EQ(scope.stats().live_bytes, 0);
+        EXPECT_EQ(scope.stats().peak_bytes, static_cast<int64_t>(10 * sizeof(int) + sizeof(long)));
+    }
+
+    TEST(AllocTracker, PeakTracksLiveBytes)
+    {
+        AllocationScope scope;
+        char* a = new char[100];
+        char* b = new char[50];
+        delete[] a;
+        char* c = new char[20];
+        delete[] b;
+        delete[] c;
+        EXPECT_EQ(scope.stats().allocations, 3);
+        EXPECT_EQ(scope.stats().deallocations, 3);
+        EXPECT_EQ(scope.stats().peak_bytes, 150);
+        EXPECT_EQ(scope.stats().live_bytes, 0);
+    }
+
+    TEST(AllocTracker, NestedScopes)
+    {
+        auto early = std::make_unique<int>(1);
+        AllocationScope outer;
+        auto first = std::make_unique<int>(2);
+        {
+            AllocationScope inner;
+            auto second = std::make_unique<int>(3);
+            early.reset();
+            EXPECT_EQ(inner.stats().allocations, 1);
+            EXPECT_EQ(inner.stats().deallocations, 1);
+            EXPECT_EQ(inner.stats().live_bytes, 0);
+        }
+        EXPECT_EQ(outer.stats().allocations, 2);
+        // early was allocated before either scope began
+        EXPECT_EQ(outer.stats().deallocations, 2);
+        EXPECT_EQ(outer.stats().live_bytes, 0);
+    }
+
+    TEST(AllocTracker, OverAlignedTypes)
+    {
+        struct alignas(64) Line {
+            char bytes[64];
+        };
+        AllocationScope scope;
+        {
+            auto single = std::make_unique<Line>();
+            std::vector<Line> lines(3);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(single.get()) % 64, 0);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(lines.data()) % 64, 0);
+            EXPECT_EQ(scope.stats().allocations, 2);
+            EXPECT_EQ(scope.stats().bytes, 4 * sizeof(Line));
+        }
+        EXPECT_EQ(scope.stats().deallocations, 2);
+        EXPECT_EQ(scope.stats().live_bytes, 0);
+
+        // The Bloom filter's cache-line blocks are such a type.
+        {
+            bst::BlockedBloomFilter filter(1000);
+            EXPECT_EQ(scope.stats().allocations, 3);
+            EXPECT_EQ(scope.stats().live_bytes, static_cast<int64_t>(filter.bytes()));
+        }
+        EXPECT_EQ(scope.stats().live_bytes, 0);
+    }
+
+    TEST(AllocTracker, HugeRequestsFail)
+    {
+        AllocationScope scope;
+        // Volatile so the compiler cannot fold the calls away.
+        volatile size_t huge = SIZE_MAX - 8;
+        EXPECT_THROW(::operator delete(::operator new(huge)), std::bad_alloc);
+        EXPECT_THROW(::operator delete(::operator new(huge, std::align_val_t{64}), std::align_val_t{64}),
+                     std::bad_alloc);
+        EXPECT_EQ(::operator new(huge, std::nothrow), nullptr);
+        EXPECT_EQ(::operator new(huge, std::align_val_t{64}, std::nothrow), nullptr);
+        EXPECT_EQ(scope.stats().allocations, 0);
+    }
+
+    TEST(AllocTracker, ContainerBudgets)
+    {
+        SplayTree<int> splay;
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_TRUE(AllocatesAtMost(1, [&] { splay.insert(i); }));
+        }
+        EXPECT_TRUE(AllocatesAtMost(0, [&] { splay.contains(42); }));
+        EXPECT_TRUE(AllocatesAtMost(0, [&] { splay.remove(42); }));
+
+        CompactBinarySearchTree<int> compact;
+        compact.reserve(1000);
+        EXPECT_TRUE(AllocatesAtMost(0, [&] {
+            for (int i = 0; i < 1000; ++i) {
+                compact.insert(i * 7 % 1000);
+            }
+        }));
+
+        EXPECT_TRUE(AllocatesAtMost(0, [] { Fraction(1, 2).to_double(); }));
+    }
+
+    TEST(AllocTracker, BudgetFailureReportsCallSites)
+    {
+        std::vector<std::unique_ptr<int>> keep;
+        ::testing::AssertionResult result = AllocatesAtMost(2, [&] {
+            keep.reserve(8);
+            for (int i = 0; i < 8; ++i) {
+                keep.push_back(std::make_unique<int>(i));
+            }
+        });
+        EXPECT_FALSE(result);
+        std::string message = result.message();
+        EXPECT_NE(message.find("expected at most 2 allocation(s), got 9"), std::string::npos) << message;
+        EXPECT_NE(message.find(" x, "), std::string::npos) << message;
+    }
+
+    TEST(AllocTracker, ReportIsNotCounted)
+    {
+        AllocationScope scope;
+        auto value = std::make_unique<int>(5);
+        std::ostringstream out;
+        scope.report(out);
+        scope.report(out);
+        EXPECT_EQ(scope.stats().allocations, 1);
+        EXPECT_NE(out.str().find("1 allocation(s), 4 byte(s)"), std::string::npos) << out.str();
+    }
+} // namespace alloc
+} // namespace cppclass
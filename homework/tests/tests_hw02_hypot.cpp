@@ -0,0 +1,91 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "hw02_hypot.h"
+#include "gtest/gtest.h"
+
+static const double ACCURACY = 2 * std::numeric_limits<double>::epsilon();
+
+TEST(HW02Hypot, HYPOT_2D) {
+    std::vector<double> x = {3.0, 5.0, 0.0, -8.0, 1.0, 20.0, 0.0};
+    std::vector<double> y = {4.0, 12.0, 0.0, 15.0, 1.0, -21.0, -7.0};
+    std::vector<double> expected = {5.0, 13.0, 0.0, 17.0, std::sqrt(2.0), 29.0, 7.0};
+    std::vector<double> out(x.size());
+    hypot_batch(x.data(), y.data(), out.data(), x.size());
+    EXPECT_EQ(out, expected);
+}
+
+TEST(HW02Hypot, HYPOT_3D) {
+    std::vector<double> x = {1.0, 2.0, 0.0, -1.0, 4.0};
+    std::vector<double> y = {2.0, 3.0, 0.0, -4.0, 4.0};
+    std::vector<double> z = {2.0, 6.0, 0.0, 8.0, 7.0};
+    std::vector<double> expected = {3.0, 7.0, 0.0, 9.0, 9.0};
+    std::vector<double> out(x.size());
+    hypot_batch(x.data(), y.data(), z.data(), out.data(), x.size());
+    EXPECT_EQ(out, expected);
+}
+
+TEST(HW02Hypot, NEEDS_SCALING) {
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> x = {3e200, 3e-200, 1e308, 5e-324, inf, nan, inf, 1.0};
+    std::vector<double> y = {4e200, 4e-200, 1e308, 0.0, nan, 1.0, 1.0, 1e-170};
+    std::vector<double> out(x.size());
+    hypot_batch(x.data(), y.data(), out.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        double expected = std::hypot(x[i], y[i]);
+        if (std::isnan(expected)) {
+            EXPECT_TRUE(std::isnan(out[i])) << i;
+        } else {
+            EXPECT_EQ(out[i], expected) << i;
+        }
+    }
+    EXPECT_NEAR(out[0], 5e200, 5e200 * ACCURACY);
+    EXPECT_NEAR(out[1], 5e-200, 5e-200 * ACCURACY);
+
+    std::vector<double> z = {0.0, 12e-200, 1e308, 0.0, 0.0, 0.0, nan, 0.0};
+    hypot_batch(x.data(), y.data(), z.data(), out.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        double expected = std::hypot(x[i], y[i], z[i]);
+        if (std::isnan(expected)) {
+            EXPECT_TRUE(std::isnan(out[i])) << i;
+        } else {
+            EXPECT_EQ(out[i], expected) << i;
+        }
+    }
+    EXPECT_NEAR(out[1], 13e-200, 13e-200 * ACCURACY);
+}
+
+TEST(HW02Hypot, MATCHES_SCALAR) {
+    std::mt19937_64 rng(2);
+    std::uniform_real_distribution<double> coordinate(-1e3, 1e3);
+    for (size_t count : {0u, 1u, 3u, 4u, 5u, 1000u, 1003u}) {
+        std::vector<double> x(count), y(count), z(count), out(count);
+        for (size_t i = 0; i < count; ++i) {
+            x[i] = coordinate(rng);
+            y[i] = coordinate(rng);
+            z[i] = coordinate(rng);
+        }
+
+        hypot_batch(x.data(), y.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(out[i], std::sqrt(x[i] * x[i] + y[i] * y[i]));
+            EXPECT_NEAR(out[i], std::hypot(x[i], y[i]), out[i] * ACCURACY);
+        }
+
+        hypot_batch(x.data(), y.data(), z.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(out[i], std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]));
+            EXPECT_NEAR(out[i], std::hypot(x[i], y[i], z[i]), out[i] * ACCURACY);
+        }
+
+        // In place
+        std::vector<double> copy = x;
+        hypot_batch(copy.data(), y.data(), copy.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(copy[i], std::sqrt(x[i] * x[i] + y[i] * y[i]));
+        }
+    }
+}
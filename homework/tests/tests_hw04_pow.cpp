@@ -0,0 +1,111 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "hw04_pow.h"
+#include "gtest/gtest.h"
+
+static bool same_bits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof a) == 0;
+}
+
+TEST(HW04Pow, POWI_EXACT) {
+    EXPECT_EQ(powi(2.0, 0), 1.0);
+    EXPECT_EQ(powi(2.0, 1), 2.0);
+    EXPECT_EQ(powi(2.0, 10), 1024.0);
+    EXPECT_EQ(powi(2.0, -3), 0.125);
+    EXPECT_EQ(powi(-3.0, 3), -27.0);
+    EXPECT_EQ(powi(-3.0, 4), 81.0);
+    EXPECT_EQ(powi(10.0, 22), 1e22);
+    EXPECT_EQ(powi(std::nan(""), 0), 1.0);
+    EXPECT_EQ(powi(0.0, -1), std::numeric_limits<double>::infinity());
+    EXPECT_EQ(powi(2.0, 1024), std::numeric_limits<double>::infinity());
+    EXPECT_EQ(powi(0.5, 1074), std::numeric_limits<double>::denorm_min());
+    EXPECT_EQ(powi(1.0, std::numeric_limits<long long>::min()), 1.0);
+}
+
+TEST(HW04Pow, POWI_ERROR_BOUND) {
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> base(0.5, 2.0);
+    std::uniform_int_distribution<int> exponent(-600, 600);
+    for (int i = 0; i < 10000; ++i) {
+        double x = base(rng);
+        int n = exponent(rng);
+        double expected = std::pow(x, n);
+        if (expected == 0.0 || std::isinf(expected) || std::fabs(expected) < std::numeric_limits<double>::min()) {
+            continue;
+        }
+        double bound = (std::abs(n) + 2) * std::ldexp(1.0, -53);
+        EXPECT_LE(std::fabs(powi(x, n) - expected) / std::fabs(expected), bound) << x << "^" << n;
+    }
+}
+
+TEST(HW04Pow, POW10I) {
+    EXPECT_EQ(pow10i(0), 1.0);
+    EXPECT_EQ(pow10i(3), 1000.0);
+    EXPECT_EQ(pow10i(22), 1e22);
+    EXPECT_EQ(pow10i(23), 1e23);
+    EXPECT_EQ(pow10i(-1), 0.1);
+    EXPECT_EQ(pow10i(-5), 1e-5);
+    EXPECT_EQ(pow10i(308), 1e308);
+    EXPECT_EQ(pow10i(-307), 1e-307);
+    EXPECT_EQ(pow10i(-323), 1e-323);
+    EXPECT_EQ(pow10i(309), std::numeric_limits<double>::infinity());
+    EXPECT_EQ(pow10i(-324), 0.0);
+}
+
+TEST(HW04Pow, BATCH_MATCHES_SCALAR) {
+    std::mt19937_64 rng(9);
+    std::uniform_real_distribution<double> base(-3.0, 3.0);
+    std::uniform_int_distribution<int> exponent(-80, 80);
+    for (size_t count : {0u, 1u, 2u, 7u, 64u, 1001u}) {
+        std::vector<double> x(count);
+        std::vector<int> n(count);
+        for (size_t i = 0; i < count; ++i) {
+            x[i] = base(rng);
+            n[i] = exponent(rng);
+        }
+        if (count > 2) {
+            x[1] = 0.0;
+            n[2] = 0;
+        }
+
+        std::vector<double> out(count);
+        powi_batch(x.data(), n.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_TRUE(same_bits(out[i], powi(x[i], n[i]))) << x[i] << "^" << n[i];
+        }
+
+        for (long long shared : {0LL, 5LL, -17LL}) {
+            powi_batch(x.data(), shared, out.data(), count);
+            for (size_t i = 0; i < count; ++i) {
+                EXPECT_TRUE(same_bits(out[i], powi(x[i], shared))) << x[i] << "^" << shared;
+            }
+        }
+
+        // In place
+        std::vector<double> copy = x;
+        powi_batch(copy.data(), 3LL, copy.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_TRUE(same_bits(copy[i], powi(x[i], 3)));
+        }
+    }
+}
+
+TEST(HW04Pow, CACHED_POW) {
+    CachedPow cached;
+    EXPECT_EQ(cached(10.0, 5.0), std::pow(10.0, 5.0));
+    EXPECT_EQ(cached(10.0, 5.0), std::pow(10.0, 5.0));
+    EXPECT_EQ(cached(10.0, 0.1), std::pow(10.0, 0.1));
+    EXPECT_EQ(cached(2.0, 0.1), std::pow(2.0, 0.1));
+    EXPECT_EQ(cached(0.0, 0.0), 1.0);
+    EXPECT_TRUE(std::isnan(cached(-1.0, 0.5)));
+
+    // Signed zeros compare equal but pow tells them apart
+    EXPECT_EQ(cached(0.0, -1.0), std::pow(0.0, -1.0));
+    EXPECT_EQ(cached(-0.0, -1.0), std::pow(-0.0, -1.0));
+    EXPECT_TRUE(std::signbit(cached(-0.0, -1.0)));
+    EXPECT_FALSE(std::signbit(cached(0.0, -1.0)));
+}
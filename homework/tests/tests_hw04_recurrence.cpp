@@ -0,0 +1,101 @@
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "hw04_recurrence.h"
+#include "gtest/gtest.h"
+
+// Direct O(k n) evaluation to check against
+static uint64_t naive_term(const std::vector<uint64_t> &c, std::vector<uint64_t> a, uint64_t m, uint64_t n) {
+    size_t k = c.size();
+    for (uint64_t i = k; i <= n; ++i) {
+        uint64_t next = 0;
+        for (size_t j = 0; j < k; ++j) {
+            next = (next + (c[j] % m) * (a[i - 1 - j] % m)) % m;
+        }
+        a.push_back(next);
+    }
+    return a[n] % m;
+}
+
+TEST(HW04Recurrence, FIBONACCI) {
+    const uint64_t m = uint64_t(1) << 32;
+    LinearRecurrence fib({1, 1}, {0, 1}, m);
+    EXPECT_EQ(fib.order(), 2u);
+    EXPECT_EQ(fib.modulus(), m);
+    EXPECT_EQ(fib.term(0), 0u);
+    EXPECT_EQ(fib.term(1), 1u);
+    EXPECT_EQ(fib.term(2), 1u);
+    EXPECT_EQ(fib.term(10), 55u);
+    EXPECT_EQ(fib.term(12), 144u);
+    EXPECT_EQ(fib.term(15), 610u);
+    // Matches unsigned int wraparound, as in HW04.FIBONACCI
+    EXPECT_EQ(fib.term(100), 3314859971u);
+}
+
+TEST(HW04Recurrence, HUGE_INDEX) {
+    // F(10^18) mod 10^9+7
+    LinearRecurrence fib({1, 1}, {0, 1}, 1000000007);
+    EXPECT_EQ(fib.term(1000000000000000000ULL), 209783453u);
+    // Pisano period of 10 is 60
+    LinearRecurrence last_digit({1, 1}, {0, 1}, 10);
+    EXPECT_EQ(last_digit.term(60ULL * 123456789 + 7), 3u);
+}
+
+TEST(HW04Recurrence, TRIBONACCI) {
+    LinearRecurrence trib({1, 1, 1}, {0, 0, 1}, 1000000007);
+    std::vector<uint64_t> expected = {0, 0, 1, 1, 2, 4, 7, 13, 24, 44, 81, 149, 274, 504};
+    for (uint64_t n = 0; n < expected.size(); ++n) {
+        EXPECT_EQ(trib.term(n), expected[n]);
+    }
+}
+
+TEST(HW04Recurrence, FIRST_ORDER) {
+    // a(n) = 3 a(n-1), a(0) = 2  ->  2 * 3^n
+    LinearRecurrence geometric({3}, {2}, 1000);
+    EXPECT_EQ(geometric.term(0), 2u);
+    EXPECT_EQ(geometric.term(1), 6u);
+    EXPECT_EQ(geometric.term(5), 486u);
+    EXPECT_EQ(geometric.term(7), (2 * 2187) % 1000u);
+}
+
+TEST(HW04Recurrence, MATCHES_NAIVE) {
+    std::mt19937_64 rng(5);
+    for (size_t k = 1; k <= 6; ++k) {
+        for (uint64_t m : {uint64_t(2), uint64_t(97), uint64_t(998244353), uint64_t(1) << 32}) {
+            std::vector<uint64_t> c(k);
+            std::vector<uint64_t> a(k);
+            for (size_t i = 0; i < k; ++i) {
+                c[i] = rng();
+                a[i] = rng();
+            }
+            LinearRecurrence r(c, a, m);
+            std::vector<uint64_t> indices;
+            for (uint64_t n = 0; n < 300; n += 7) {
+                indices.push_back(n);
+            }
+            std::vector<uint64_t> batch = r.terms(indices);
+            ASSERT_EQ(batch.size(), indices.size());
+            for (size_t i = 0; i < indices.size(); ++i) {
+                uint64_t expected = naive_term(c, a, m, indices[i]);
+                EXPECT_EQ(batch[i], expected) << "k=" << k << " m=" << m << " n=" << indices[i];
+                EXPECT_EQ(r.term(indices[i]), expected);
+            }
+        }
+    }
+}
+
+TEST(HW04Recurrence, BATCH_KEEPS_ORDER) {
+    LinearRecurrence fib({1, 1}, {0, 1}, 1000000007);
+    std::vector<uint64_t> indices = {1000000000000000000ULL, 0, 10, 1, 15, 10};
+    std::vector<uint64_t> expected = {209783453, 0, 55, 1, 610, 55};
+    EXPECT_EQ(fib.terms(indices), expected);
+    EXPECT_TRUE(fib.terms({}).empty());
+}
+
+TEST(HW04Recurrence, INVALID) {
+    EXPECT_THROW(LinearRecurrence({}, {}, 10), std::invalid_argument);
+    EXPECT_THROW(LinearRecurrence({1, 1}, {0}, 10), std::invalid_argument);
+    EXPECT_THROW(LinearRecurrence({1}, {0}, 0), std::invalid_argument);
+    EXPECT_THROW(LinearRecurrence({1}, {0}, (uint64_t(1) << 32) + 1), std::invalid_argument);
+}
@@ -1,5 +1,6 @@
 #include "hw07.h"
 #include "gtest/gtest.h"
+#include <cmath>
 #include <stdexcept>
 #include <iostream>
 
@@ -267,4 +268,56 @@ TEST(HW07, fraction_divide)
     }
 }
 
+TEST(HW07, from_double)
+{
+    struct TestDefinition {
+        double x;
+        int max_denominator;
+        int numerator;
+        int denominator;
+    };
+
+    TestDefinition test_defs[] = {
+        {0.0, 10, 0, 1},
+        {0.5, 10, 1, 2},
+        {-0.75, 100, -3, 4},
+        {3.0, 1, 3, 1},
+        {2.6, 1, 3, 1},
+        {2.4, 1, 2, 1},
+        {0.0001, 10, 0, 1},
+        {0.333333, 100, 1, 3},
+        {-0.333333, 100, -1, 3},
+        {3.141592653589793, 10, 22, 7},
+        {3.141592653589793, 100, 311, 99},
+        {3.141592653589793, 1000, 355, 113},
+        {1.0 / 7.0, 1000000, 1, 7},
+        {1e-30, 1000, 0, 1},
+    };
+
+    {
+        for (auto& test : test_defs) {
+            cppclass::Fraction f = cppclass::Fraction::from_double(test.x, test.max_denominator);
+            EXPECT_EQ(f._numerator, test.numerator) << test.x << " / " << test.max_denominator;
+            EXPECT_EQ(f._denominator, test.denominator) << test.x << " / " << test.max_denominator;
+        }
+    }
+
+    EXPECT_THROW(cppclass::Fraction::from_double(1e10, 10), std::overflow_error);
+    EXPECT_THROW(cppclass::Fraction::from_double(0x1p40, 10), std::overflow_error);
+    EXPECT_THROW(cppclass::Fraction::from_double(-0x1p40, 10), std::overflow_error);
+    EXPECT_THROW(cppclass::Fraction::from_double(0x1p80, 10), std::overflow_error);
+    EXPECT_THROW(cppclass::Fraction::from_double(-0x1p80, 10), std::overflow_error);
+    EXPECT_THROW(cppclass::Fraction::from_double(0.5, 0), std::invalid_argument);
+    EXPECT_THROW(cppclass::Fraction::from_double(NAN, 10), std::invalid_argument);
+    EXPECT_THROW(cppclass::Fraction::from_double(INFINITY, 10), std::invalid_argument);
+}
+
+TEST(HW07, to_double)
+{
+    EXPECT_EQ(cppclass::Fraction(1, 2).to_double(), 0.5);
+    EXPECT_EQ(cppclass::Fraction(-3, 4).to_double(), -0.75);
+    EXPECT_EQ(cppclass::Fraction(1, 3).to_double(), 1.0 / 3.0);
+    EXPECT_EQ(cppclass::Fraction(5, 1).to_double(), 5.0);
+}
+
 }
@@ -0,0 +1,143 @@
+#include "hw07_charconv.h"
+#include "gtest/gtest.h"
+#include <climits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cppclass
+{
+namespace
+{
+    std::from_chars_result parse(std::string_view text, Fraction &f)
+    {
+        return from_chars(text.data(), text.data() + text.size(), f);
+    }
+}
+
+TEST(HW07Charconv, to_chars_single)
+{
+    struct TestDefinition {
+        int numerator;
+        int denominator;
+        const char *text;
+    };
+
+    TestDefinition test_defs[] = {
+        {0, 1, "0/1"},
+        {3, 4, "3/4"},
+        {-7, 2, "-7/2"},
+        {INT_MIN, INT_MAX, "-2147483648/2147483647"},
+    };
+
+    for (auto& test : test_defs) {
+        char buffer[fraction_max_chars];
+        auto result = to_chars(buffer, buffer + sizeof buffer, Fraction(test.numerator, test.denominator));
+        ASSERT_EQ(result.ec, std::errc());
+        EXPECT_EQ(std::string(buffer, result.ptr), test.text);
+    }
+
+    char small[3];
+    auto result = to_chars(small, small + sizeof small, Fraction(12, 5));
+    EXPECT_EQ(result.ec, std::errc::value_too_large);
+}
+
+TEST(HW07Charconv, from_chars_single)
+{
+    struct TestDefinition {
+        const char *text;
+        int numerator;
+        int denominator;
+        size_t consumed;
+    };
+
+    TestDefinition test_defs[] = {
+        {"3/4", 3, 4, 3},
+        {"-3/4", -3, 4, 4},
+        {"3/-4", 3, -4, 4},
+        {"42", 42, 1, 2},
+        {"42 rest", 42, 1, 2},
+        {"12345678/87654321", 12345678, 87654321, 17},
+        {"123456789/1000000007xyz", 123456789, 1000000007, 20},
+        {"0000000000000000000000017/2", 17, 2, 27},
+        {"2147483647/1", INT_MAX, 1, 12},
+        {"-2147483648/1", INT_MIN, 1, 13},
+    };
+
+    for (auto& test : test_defs) {
+        Fraction f(9, 9);
+        std::string_view text(test.text);
+        auto result = parse(text, f);
+        ASSERT_EQ(result.ec, std::errc()) << test.text;
+        EXPECT_EQ(static_cast<size_t>(result.ptr - text.data()), test.consumed) << test.text;
+        EXPECT_EQ(f.numerator(), test.numerator) << test.text;
+        EXPECT_EQ(f.denominator(), test.denominator) << test.text;
+    }
+}
+
+TEST(HW07Charconv, from_chars_errors)
+{
+    const char *invalid[] = {"", "-", "+3/4", " 3/4", "/4", "3/", "3/x", "3/0", "3/-"};
+    for (const char *text : invalid) {
+        Fraction f(9, 9);
+        std::string_view view(text);
+        auto result = parse(view, f);
+        EXPECT_EQ(result.ec, std::errc::invalid_argument) << text;
+        EXPECT_EQ(result.ptr, view.data()) << text;
+        EXPECT_EQ(f.numerator(), 9) << text;
+    }
+
+    const char *too_big[] = {"2147483648/1", "-2147483649", "1/99999999999", "123456789012345678901234567890"};
+    for (const char *text : too_big) {
+        Fraction f(9, 9);
+        auto result = parse(text, f);
+        EXPECT_EQ(result.ec, std::errc::result_out_of_range) << text;
+        EXPECT_EQ(f.numerator(), 9) << text;
+    }
+}
+
+TEST(HW07Charconv, bulk_round_trip)
+{
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> numerator(INT_MIN, INT_MAX);
+    std::uniform_int_distribution<int> denominator(1, INT_MAX);
+    std::vector<Fraction> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.emplace_back(numerator(rng) >> (i % 31), (denominator(rng) >> (i % 29)) | 1);
+    }
+
+    std::vector<char> text(values.size() * (fraction_max_chars + 1));
+    auto written = to_chars(text.data(), text.data() + text.size(), values.data(), values.size(), '\n');
+    ASSERT_EQ(written.ec, std::errc());
+
+    std::vector<Fraction> parsed;
+    auto read = from_chars(text.data(), written.ptr, parsed);
+    ASSERT_EQ(read.ec, std::errc());
+    EXPECT_EQ(read.ptr, written.ptr);
+    ASSERT_EQ(parsed.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(parsed[i].numerator(), values[i].numerator());
+        EXPECT_EQ(parsed[i].denominator(), values[i].denominator());
+    }
+}
+
+TEST(HW07Charconv, bulk_stops_at_bad_token)
+{
+    std::string_view text = "1/2 \t3/4\n\n5 6/x 7/8";
+    std::vector<Fraction> parsed;
+    auto result = from_chars(text.data(), text.data() + text.size(), parsed);
+    EXPECT_EQ(result.ec, std::errc::invalid_argument);
+    EXPECT_EQ(result.ptr, text.data() + text.find("6/x"));
+    ASSERT_EQ(parsed.size(), 3u);
+    EXPECT_EQ(parsed[2].numerator(), 5);
+
+    text = "1/2 3/4junk";
+    parsed.clear();
+    result = from_chars(text.data(), text.data() + text.size(), parsed);
+    EXPECT_EQ(result.ec, std::errc::invalid_argument);
+    EXPECT_EQ(result.ptr, text.data() + 4);
+    EXPECT_EQ(parsed.size(), 1u);
+}
+
+}
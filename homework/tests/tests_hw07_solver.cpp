@@ -0,0 +1,207 @@
+#include "hw07_solver.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace cppclass
+{
+namespace
+{
+    // Checks a * x == b with every product accumulated over a common denominator
+    bool satisfies(const std::vector<std::vector<long long>> &a, const std::vector<long long> &b,
+                   const std::vector<Fraction> &x)
+    {
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            __int128 lcm = 1;
+            for (const Fraction &f : x)
+            {
+                __int128 d = f.denominator();
+                __int128 g = lcm, h = d;
+                while (h != 0)
+                {
+                    __int128 r = g % h;
+                    g = h;
+                    h = r;
+                }
+                lcm = lcm / g * d;
+            }
+            __int128 sum = 0;
+            for (size_t j = 0; j < x.size(); ++j)
+            {
+                sum += a[i][j] * (lcm / x[j].denominator()) * x[j].numerator();
+            }
+            if (sum != b[i] * lcm)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST(HW07Solver, integer_solution)
+{
+    std::vector<std::vector<long long>> a = {{1, 1}, {1, -1}};
+    std::vector<long long> b = {3, 1};
+    std::vector<Fraction> x;
+    ASSERT_EQ(solve_exact(a, b, x), SolveStatus::Ok);
+    ASSERT_EQ(x.size(), 2u);
+    EXPECT_EQ(x[0].numerator(), 2);
+    EXPECT_EQ(x[0].denominator(), 1);
+    EXPECT_EQ(x[1].numerator(), 1);
+    EXPECT_EQ(x[1].denominator(), 1);
+}
+
+TEST(HW07Solver, fractional_solution)
+{
+    std::vector<std::vector<long long>> a = {{2, 1}, {1, 3}};
+    std::vector<long long> b = {1, -2};
+    std::vector<Fraction> x;
+    ASSERT_EQ(solve_exact(a, b, x), SolveStatus::Ok);
+    EXPECT_EQ(x[0].numerator(), 1);
+    EXPECT_EQ(x[0].denominator(), 1);
+    EXPECT_EQ(x[1].numerator(), -1);
+    EXPECT_EQ(x[1].denominator(), 1);
+
+    b = {1, 2};
+    ASSERT_EQ(solve_exact(a, b, x), SolveStatus::Ok);
+    EXPECT_EQ(x[0].numerator(), 1);
+    EXPECT_EQ(x[0].denominator(), 5);
+    EXPECT_EQ(x[1].numerator(), 3);
+    EXPECT_EQ(x[1].denominator(), 5);
+}
+
+TEST(HW07Solver, needs_row_swap)
+{
+    std::vector<std::vector<long long>> a = {{0, 2, 1}, {1, 0, 0}, {0, 1, 1}};
+    std::vector<long long> b = {5, 7, 3};
+    std::vector<Fraction> x;
+    ASSERT_EQ(solve_exact(a, b, x), SolveStatus::Ok);
+    EXPECT_TRUE(satisfies(a, b, x));
+    EXPECT_EQ(x[0].numerator(), 7);
+    EXPECT_EQ(x[1].numerator(), 2);
+    EXPECT_EQ(x[2].numerator(), 1);
+}
+
+TEST(HW07Solver, singular)
+{
+    std::vector<std::vector<long long>> a = {{1, 2, 3}, {2, 4, 6}, {1, 0, 1}};
+    std::vector<long long> b = {1, 2, 3};
+    std::vector<Fraction> x = {Fraction(1, 1)};
+    EXPECT_EQ(solve_exact(a, b, x), SolveStatus::Singular);
+    EXPECT_TRUE(x.empty());
+}
+
+TEST(HW07Solver, bad_shape)
+{
+    std::vector<std::vector<long long>> a = {{1, 2}, {3}};
+    std::vector<long long> b = {1, 2};
+    std::vector<Fraction> x;
+    EXPECT_THROW(solve_exact(a, b, x), std::invalid_argument);
+    a = {{1, 2}, {3, 4}};
+    b = {1};
+    EXPECT_THROW(solve_exact(a, b, x), std::invalid_argument);
+}
+
+TEST(HW07Solver, random_systems)
+{
+    std::mt19937 rng(7);
+    // Small enough that every minor, hence every answer, fits in an int
+    std::uniform_int_distribution<long long> entry(-9, 9);
+    for (size_t n = 1; n <= 6; ++n)
+    {
+        for (int trial = 0; trial < 20; ++trial)
+        {
+            std::vector<std::vector<long long>> a(n, std::vector<long long>(n));
+            std::vector<long long> b(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                for (size_t j = 0; j < n; ++j)
+                {
+                    a[i][j] = entry(rng);
+                }
+                b[i] = entry(rng);
+            }
+            std::vector<Fraction> x;
+            SolveStatus status = solve_exact(a, b, x);
+            if (status == SolveStatus::Ok)
+            {
+                EXPECT_TRUE(satisfies(a, b, x)) << "n = " << n << ", trial " << trial;
+            }
+            else
+            {
+                EXPECT_EQ(status, SolveStatus::Singular);
+            }
+        }
+    }
+}
+
+TEST(HW07Solver, wide_fallback)
+{
+    // Entries near 2^40 overflow 64-bit cross products, but the answers are small
+    const long long big = 1LL << 40;
+    std::vector<std::vector<long long>> a = {{big, 1}, {1, big}};
+    std::vector<long long> b = {big + 1, big + 1};
+    std::vector<Fraction> x;
+    ASSERT_EQ(solve_exact(a, b, x), SolveStatus::Ok);
+    EXPECT_EQ(x[0].numerator(), 1);
+    EXPECT_EQ(x[1].numerator(), 1);
+}
+
+TEST(HW07Solver, minimum_over_negative_pivot)
+{
+    // The second step computes -2^63 and divides it by the first pivot, -1
+    std::vector<std::vector<long long>> a = {{-1, 0}, {0, 1LL << 33}};
+    std::vector<long long> b = {1LL << 30, 1LL << 33};
+    std::vector<Fraction> x;
+    ASSERT_EQ(solve_exact(a, b, x), SolveStatus::Ok);
+    EXPECT_EQ(x[0].numerator(), -(1 << 30));
+    EXPECT_EQ(x[0].denominator(), 1);
+    EXPECT_EQ(x[1].numerator(), 1);
+    EXPECT_EQ(x[1].denominator(), 1);
+}
+
+TEST(HW07Solver, overflow)
+{
+    const long long big = 1LL << 62;
+    std::vector<std::vector<long long>> a = {{big, big - 1, 3}, {big - 5, big, big - 2}, {7, big - 9, big}};
+    std::vector<long long> b = {1, 2, 3};
+    std::vector<Fraction> x;
+    EXPECT_EQ(solve_exact(a, b, x), SolveStatus::Overflow);
+    EXPECT_TRUE(x.empty());
+}
+
+TEST(HW07Solver, hilbert_fractions)
+{
+    // H x = H * (1, ..., 1) has the all-ones solution
+    const int n = 7;
+    std::vector<std::vector<Fraction>> a;
+    std::vector<Fraction> b;
+    for (int i = 0; i < n; ++i)
+    {
+        std::vector<Fraction> row;
+        for (int j = 0; j < n; ++j)
+        {
+            row.emplace_back(1, i + j + 1);
+        }
+        a.push_back(row);
+    }
+    // Row sums of the 7x7 Hilbert matrix
+    const int sums[n][2] = {{363, 140}, {481, 280}, {3349, 2520}, {2761, 2520}, {25961, 27720},
+                            {22727, 27720}, {263111, 360360}};
+    for (int i = 0; i < n; ++i)
+    {
+        b.emplace_back(sums[i][0], sums[i][1]);
+    }
+    std::vector<Fraction> x;
+    ASSERT_EQ(solve_exact(a, b, x), SolveStatus::Ok);
+    for (const Fraction &f : x)
+    {
+        EXPECT_EQ(f.numerator(), 1);
+        EXPECT_EQ(f.denominator(), 1);
+    }
+}
+
+}
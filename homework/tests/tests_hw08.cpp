@@ -3,6 +3,8 @@
 #include "gtest/gtest_prod.h"
 #include <stdexcept>
 #include <iostream>
+#include <type_traits>
+#include <vector>
 
 namespace cppclass
 {
@@ -243,6 +245,41 @@ namespace cppclass
         EXPECT_EQ(moved.m_size, 5);
     }
 
+    // std::vector only moves its elements on reallocation if the move cannot throw.
+    static_assert(std::is_nothrow_move_constructible_v<LinkedList>);
+    static_assert(std::is_nothrow_move_assignable_v<LinkedList>);
+    static_assert(std::is_nothrow_swappable_v<LinkedList>);
+
+    TEST_F(BasicLinkedListTest, Swap)
+    {
+        LinkedList::Node a0, a1, b0;
+        a0.next = &a1;
+        a1.prev = &a0;
+
+        LinkedList a;
+        LinkedList b;
+        a.m_head = &a0;
+        a.m_tail = &a1;
+        a.m_size = 2;
+        b.m_head = b.m_tail = &b0;
+        b.m_size = 1;
+
+        swap(a, b);
+        EXPECT_EQ(a.m_head, &b0);
+        EXPECT_EQ(a.m_tail, &b0);
+        EXPECT_EQ(a.m_size, 1);
+        EXPECT_EQ(b.m_head, &a0);
+        EXPECT_EQ(b.m_tail, &a1);
+        EXPECT_EQ(b.m_size, 2);
+
+        a.swap(a);
+        EXPECT_EQ(a.m_head, &b0);
+
+        // The nodes live on the stack; detach them before the destructors run.
+        a.m_head = a.m_tail = b.m_head = b.m_tail = nullptr;
+        a.m_size = b.m_size = 0;
+    }
+
     TEST_F(BasicLinkedListTest, MultiRandom)
     {
         LinkedList ll;
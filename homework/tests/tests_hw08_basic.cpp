@@ -0,0 +1,218 @@
+#include "alloc_tracker.h"
+#include "hw08_basic.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cppclass
+{
+namespace
+{
+    struct Record {
+        Record(int id, std::string name, double score) : id(id), name(std::move(name)), score(score) {}
+
+        bool operator==(const Record& other) const
+        {
+            return id == other.id && name == other.name && score == other.score;
+        }
+
+        int id;
+        std::string name;
+        double score;
+    };
+
+    // Throws from its constructor when asked to, to check the list is left intact.
+    struct Fussy {
+        explicit Fussy(int value) : value(value)
+        {
+            if (value < 0) {
+                throw std::invalid_argument("negative");
+            }
+        }
+
+        int value;
+    };
+
+    // Throws from its move constructor once moves_left runs out.
+    struct Brittle {
+        static inline int moves_left = -1;
+
+        explicit Brittle(int value) : value(value) {}
+        Brittle(Brittle&& other) : value(other.value)
+        {
+            if (moves_left >= 0 && moves_left-- == 0) {
+                throw std::runtime_error("move failed");
+            }
+        }
+
+        int value;
+    };
+
+    template <typename T, typename Alloc>
+    void Validate(const BasicLinkedList<T, Alloc>& ll)
+    {
+        auto p = ll.at(0);
+        size_t count = 0;
+        if (p != nullptr) {
+            ASSERT_EQ(p->prev, nullptr);
+        }
+        for (; p != nullptr; p = p->next) {
+            ++count;
+            if (p->next != nullptr) {
+                ASSERT_EQ(p, p->next->prev);
+            } else {
+                ASSERT_EQ(p, ll.at(static_cast<unsigned>(ll.get_size() - 1)));
+            }
+        }
+        ASSERT_EQ(count, ll.get_size());
+    }
+}
+
+    TEST(BasicLinkedList, AppendInsertErase)
+    {
+        int values[] = {1, 2, 3, 4};
+        BasicLinkedList<int> ll(values, 4);
+        Validate(ll);
+        EXPECT_EQ(ll.get_size(), 4);
+
+        ll.insert(0);
+        ll.append(5);
+        ll.append(25, ll.search(2));
+        ll.insert(15, ll.search(2));
+        Validate(ll);
+        int expected[] = {0, 1, 15, 2, 25, 3, 4, 5};
+        EXPECT_TRUE(ll == BasicLinkedList<int>(expected, 8));
+
+        ll.erase(ll.at(0));
+        ll.erase(ll.search(5));
+        ll.erase(ll.search(2));
+        ll.erase(nullptr);
+        Validate(ll);
+        int rest[] = {1, 15, 25, 3, 4};
+        EXPECT_TRUE(ll == BasicLinkedList<int>(rest, 5));
+        EXPECT_TRUE(ll != BasicLinkedList<int>(expected, 8));
+        EXPECT_EQ(ll.search(99), nullptr);
+        EXPECT_EQ(ll.at(5), nullptr);
+
+        while (ll.get_size() > 0) {
+            ll.erase(ll.at(ll.get_size() / 2));
+            Validate(ll);
+        }
+        EXPECT_EQ(ll.at(0), nullptr);
+    }
+
+    TEST(BasicLinkedList, EmplaceConstructsInPlace)
+    {
+        BasicLinkedList<Record> records;
+        auto bob = records.emplace_append(nullptr, 2, "bob", 1.5);
+        records.emplace_insert(bob, 1, "alice", 3.0);
+        records.emplace_append(bob, 3, std::string(40, 'c'), 0.5);
+        Validate(records);
+        ASSERT_EQ(records.get_size(), 3);
+        EXPECT_EQ(records.at(0)->data.name, "alice");
+        EXPECT_EQ(records.at(1), bob);
+        EXPECT_EQ(records.at(2)->data.id, 3);
+
+        // One node allocation per element, and nothing else for a short name.
+        EXPECT_TRUE(alloc::AllocatesAtMost(1, [&] { records.emplace_append(nullptr, 4, "dan", 2.0); }));
+
+        BasicLinkedList<Record> copy(records);
+        EXPECT_TRUE(copy == records);
+        copy.at(0)->data.score = 0;
+        EXPECT_TRUE(copy != records);
+    }
+
+    TEST(BasicLinkedList, MoveOnlyElements)
+    {
+        BasicLinkedList<std::unique_ptr<int>> owners;
+        owners.append(std::make_unique<int>(2));
+        owners.insert(std::make_unique<int>(1));
+        owners.emplace_append(nullptr, new int(3));
+        Validate(owners);
+        ASSERT_EQ(owners.get_size(), 3);
+        for (unsigned i = 0; i < 3; ++i) {
+            EXPECT_EQ(*owners.at(i)->data, static_cast<int>(i) + 1);
+        }
+
+        auto second = owners.at(1);
+        BasicLinkedList<std::unique_ptr<int>> moved(std::move(owners));
+        EXPECT_EQ(owners.get_size(), 0);
+        EXPECT_EQ(owners.at(0), nullptr);
+        EXPECT_EQ(moved.at(1), second);
+        moved.erase(second);
+        Validate(moved);
+        EXPECT_EQ(*moved.at(1)->data, 3);
+    }
+
+    TEST(BasicLinkedList, AssignAndSwap)
+    {
+        int values[] = {1, 2, 3, 4, 5};
+        BasicLinkedList<int> a(values, 5);
+        BasicLinkedList<int> b(values, 2);
+        auto first = a.at(0);
+
+        swap(a, b);
+        EXPECT_EQ(a.get_size(), 2);
+        EXPECT_EQ(b.at(0), first);
+
+        a = b;
+        EXPECT_TRUE(a == b);
+        EXPECT_NE(a.at(0), first);
+        Validate(a);
+
+        BasicLinkedList<std::unique_ptr<int>> owners;
+        owners.emplace_append(nullptr, new int(1));
+        BasicLinkedList<std::unique_ptr<int>> other;
+        other = std::move(owners);
+        EXPECT_EQ(owners.get_size(), 0);
+        ASSERT_EQ(other.get_size(), 1);
+        EXPECT_EQ(*other.at(0)->data, 1);
+        Validate(other);
+
+        // Growing a vector relocates the lists without touching a single node.
+        std::vector<BasicLinkedList<int>> lists(1);
+        lists[0].append(7);
+        auto node = lists[0].at(0);
+        EXPECT_TRUE(alloc::AllocatesAtMost(1, [&] { lists.resize(lists.capacity() + 1); }));
+        EXPECT_EQ(lists[0].at(0), node);
+    }
+
+    TEST(BasicLinkedList, ThrowingConstructorLeavesListIntact)
+    {
+        BasicLinkedList<Fussy> ll;
+        ll.emplace_append(nullptr, 1);
+        ll.emplace_append(nullptr, 2);
+        EXPECT_THROW(ll.emplace_insert(ll.at(1), -1), std::invalid_argument);
+        EXPECT_THROW(ll.emplace_append(nullptr, -2), std::invalid_argument);
+        Validate(ll);
+        EXPECT_EQ(ll.get_size(), 2);
+        EXPECT_EQ(ll.at(1)->data.value, 2);
+    }
+
+    TEST(BasicLinkedList, MoveAssignThrowingElementLeavesTargetEmpty)
+    {
+        std::pmr::unsynchronized_pool_resource source_resource;
+        std::pmr::unsynchronized_pool_resource target_resource;
+        pmr::BasicLinkedList<Brittle> source(&source_resource);
+        pmr::BasicLinkedList<Brittle> target(&target_resource);
+        for (int i = 0; i < 5; ++i) {
+            source.emplace_append(nullptr, i);
+        }
+        target.emplace_append(nullptr, 9);
+
+        // Different resources, so the elements are moved one by one into new nodes.
+        Brittle::moves_left = 3;
+        EXPECT_THROW(target = std::move(source), std::runtime_error);
+        Brittle::moves_left = -1;
+
+        EXPECT_EQ(target.get_size(), 0);
+        EXPECT_EQ(target.at(0), nullptr);
+        EXPECT_EQ(source.get_size(), 5);
+        target.emplace_append(nullptr, 8);
+        Validate(target);
+        EXPECT_EQ(target.get_size(), 1);
+    }
+}
@@ -1 +1,22 @@
 #include <hw09.h>
+#include <hw09_compact.h>
+#include <hw09_interval.h>
+#include <hw09_radix.h>
+#include <hw09_splay.h>
+#include <string>
+#include <type_traits>
+
+namespace cppclass
+{
+    // std::vector only moves its elements on reallocation if the move cannot throw.
+    template <typename Tree>
+    constexpr bool cheap_to_relocate = std::is_nothrow_move_constructible_v<Tree>
+        && std::is_nothrow_move_assignable_v<Tree>
+        && std::is_nothrow_swappable_v<Tree>;
+
+    static_assert(cheap_to_relocate<BinarySearchTree<int>>);
+    static_assert(cheap_to_relocate<SplayTree<int>>);
+    static_assert(cheap_to_relocate<CompactBinarySearchTree<int>>);
+    static_assert(cheap_to_relocate<RadixTree<std::string>>);
+    static_assert(cheap_to_relocate<IntervalTree<int>>);
+}
@@ -0,0 +1,187 @@
+#include "hw09_bloom.h"
+#include "hw09_compact.h"
+#include "hw09_splay.h"
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace cppclass
+{
+    // std::set with the container interface BloomFiltered expects, counting lookups.
+    struct CountingSet
+    {
+        std::set<int> values;
+        mutable size_t lookups = 0;
+
+        bool insert(int value) { return values.insert(value).second; }
+        bool remove(int value) { return values.erase(value) > 0; }
+        bool contains(int value) const
+        {
+            ++lookups;
+            return values.count(value) > 0;
+        }
+        size_t size() const { return values.size(); }
+
+        template <typename Visit>
+        void for_each(Visit&& visit) const
+        {
+            for (int value : values) {
+                visit(value);
+            }
+        }
+    };
+
+    TEST(HW09Bloom, NoFalseNegatives)
+    {
+        bst::BlockedBloomFilter filter(100000);
+        for (int i = 0; i < 100000; ++i) {
+            filter.add(bst::priority(i));
+        }
+        for (int i = 0; i < 100000; ++i) {
+            ASSERT_TRUE(filter.may_contain(bst::priority(i))) << i;
+        }
+    }
+
+    TEST(HW09Bloom, FalsePositiveRate)
+    {
+        bst::BlockedBloomFilter filter(100000);
+        EXPECT_GE(filter.capacity(), 100000);
+        EXPECT_EQ(filter.bytes() % bst::BlockedBloomFilter::block_bytes, 0);
+        for (int i = 0; i < 100000; ++i) {
+            filter.add(bst::priority(i));
+        }
+        int hits = 0;
+        for (int i = 100000; i < 1100000; ++i) {
+            hits += filter.may_contain(bst::priority(i));
+        }
+        // About 0.18% expected at 16 bits per key: 1800 of the million probes.
+        EXPECT_LT(hits, 2200);
+    }
+
+#ifdef HW09_BLOOM_AVX2
+    TEST(HW09Bloom, Avx2MatchesScalar)
+    {
+        if (!bst::detail::have_avx2()) {
+            GTEST_SKIP() << "no AVX2";
+        }
+        alignas(64) uint32_t scalar[16] = {};
+        alignas(64) uint32_t vector[16] = {};
+        std::mt19937 rng(7);
+        for (int i = 0; i < 50; ++i) {
+            uint32_t key = rng();
+            bst::detail::bloom_set_scalar(scalar, key);
+            bst::detail::bloom_set_avx2(vector, key);
+        }
+        for (int i = 0; i < 16; ++i) {
+            EXPECT_EQ(scalar[i], vector[i]);
+        }
+        for (int i = 0; i < 10000; ++i) {
+            uint32_t key = rng();
+            EXPECT_EQ(bst::detail::bloom_test_scalar(scalar, key), bst::detail::bloom_test_avx2(scalar, key));
+        }
+    }
+#endif
+
+    TEST(HW09Bloom, SkipsContainerForAbsentValues)
+    {
+        BloomFiltered<CountingSet> set;
+        for (int i = 0; i < 10000; i += 2) {
+            EXPECT_TRUE(set.insert(i));
+        }
+        EXPECT_FALSE(set.insert(0));
+        for (int i = 0; i < 10000; ++i) {
+            EXPECT_EQ(set.contains(i), i % 2 == 0);
+        }
+        // Every present value reaches the container; almost no absent one does.
+        EXPECT_LT(set.container().lookups, 5000 + 50);
+        EXPECT_GE(set.filter().capacity(), set.size());
+    }
+
+    TEST(HW09Bloom, RebuildsAfterRemovals)
+    {
+        BloomFiltered<CountingSet> set;
+        for (int i = 0; i < 1000; ++i) {
+            set.insert(i);
+        }
+        for (int i = 0; i < 900; ++i) {
+            EXPECT_TRUE(set.remove(i));
+            EXPECT_LE(set.stale(), set.size() / 4 + 16);
+        }
+        EXPECT_FALSE(set.remove(0));
+
+        set.rebuild();
+        EXPECT_EQ(set.stale(), 0);
+        size_t before = set.container().lookups;
+        for (int i = 0; i < 900; ++i) {
+            EXPECT_FALSE(set.contains(i));
+        }
+        EXPECT_LT(set.container().lookups - before, 10);
+        for (int i = 900; i < 1000; ++i) {
+            EXPECT_TRUE(set.contains(i));
+        }
+    }
+
+    TEST(HW09Bloom, MatchesStdSet)
+    {
+        BloomFiltered<SplayTree<int>> splay;
+        BloomFiltered<CompactBinarySearchTree<int>> compact;
+        std::set<int> model;
+        std::mt19937 rng(3);
+        std::uniform_int_distribution<int> value(0, 4000);
+        for (int i = 0; i < 40000; ++i) {
+            int v = value(rng);
+            switch (rng() % 3) {
+            case 0:
+                EXPECT_EQ(splay.insert(v), model.insert(v).second);
+                compact.insert(v);
+                break;
+            case 1:
+                EXPECT_EQ(splay.remove(v), model.erase(v) > 0);
+                compact.remove(v);
+                break;
+            default:
+                EXPECT_EQ(splay.contains(v), model.count(v) > 0);
+                EXPECT_EQ(compact.contains(v), model.count(v) > 0);
+                break;
+            }
+        }
+        EXPECT_EQ(splay.size(), model.size());
+        EXPECT_EQ(compact.size(), model.size());
+    }
+
+    TEST(HW09Bloom, Copy)
+    {
+        BloomFiltered<SplayTree<int>> a;
+        for (int i = 0; i < 100; ++i) {
+            a.insert(i);
+        }
+        BloomFiltered<SplayTree<int>> b(a);
+        const BloomFiltered<SplayTree<int>>& ca = a;
+        BloomFiltered<SplayTree<int>> c(ca);
+        EXPECT_TRUE(a.remove(5));
+        EXPECT_EQ(b.size(), 100);
+        EXPECT_EQ(c.size(), 100);
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_TRUE(b.contains(i)) << i;
+        }
+        EXPECT_FALSE(a.contains(5));
+
+        BloomFiltered<SplayTree<int>> d(std::move(b));
+        EXPECT_EQ(d.size(), 100);
+        b = d;
+        EXPECT_TRUE(b.contains(5));
+    }
+
+    TEST(HW09Bloom, SplayForEachIsInOrder)
+    {
+        SplayTree<int> tree;
+        for (int v : {5, 1, 9, 3, 7}) {
+            tree.insert(v);
+        }
+        std::vector<int> seen;
+        tree.for_each([&](int v) { seen.push_back(v); });
+        EXPECT_EQ(seen, (std::vector<int>{1, 3, 5, 7, 9}));
+    }
+}
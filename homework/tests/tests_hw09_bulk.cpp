@@ -0,0 +1,161 @@
+#include "hw09.h"
+#include "bst_harness.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace cppclass
+{
+    using Node = BinarySearchTree<int>::Node;
+
+    static void collect(const Node* root, std::vector<int>& out)
+    {
+        if (root == nullptr) {
+            return;
+        }
+        collect(root->left, out);
+        out.push_back(root->data);
+        collect(root->right, out);
+    }
+
+    static Node* chain(int count)
+    {
+        Node* root = nullptr;
+        Node** slot = &root;
+        for (int i = 0; i < count; ++i) {
+            *slot = new Node(i);
+            slot = &(*slot)->right;
+        }
+        return root;
+    }
+
+    TEST(HW09Bulk, Rebalance)
+    {
+        Node* root = bst::rebalance(chain(100000));
+        bst::Verification facts = bst::verify(root, 0);
+        EXPECT_TRUE(facts.ordered);
+        EXPECT_TRUE(facts.heap_ordered);
+        EXPECT_EQ(facts.count, 100000);
+        EXPECT_LT(facts.height, 80);
+        bst::destroy(root);
+    }
+
+    TEST(HW09Bulk, RemoveIf)
+    {
+        Node* root = chain(1000);
+        size_t removed = bst::remove_if(root, [](int v) { return v % 3 == 0; });
+        EXPECT_EQ(removed, 334);
+
+        std::vector<int> values;
+        collect(root, values);
+        ASSERT_EQ(values.size(), 666);
+        EXPECT_TRUE(std::none_of(values.begin(), values.end(), [](int v) { return v % 3 == 0; }));
+        EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+        EXPECT_TRUE(bst::verify(root).heap_ordered);
+
+        EXPECT_EQ(bst::remove_if(root, [](int) { return true; }), 666);
+        EXPECT_EQ(root, nullptr);
+    }
+
+    TEST(HW09Bulk, RemoveIfThrowingPredicateLeavesTreeIntact)
+    {
+        Node* root = bst::rebalance(chain(1000));
+        int calls = 0;
+        auto fail_late = [&](int v) {
+            if (++calls == 700) {
+                throw std::runtime_error("predicate failed");
+            }
+            return v % 2 == 0;
+        };
+        EXPECT_THROW(bst::remove_if(root, fail_late), std::runtime_error);
+
+        std::vector<int> values;
+        collect(root, values);
+        std::vector<int> expected(1000);
+        std::iota(expected.begin(), expected.end(), 0);
+        EXPECT_EQ(values, expected);
+        bst::Verification facts = bst::verify(root, 0);
+        EXPECT_TRUE(facts.heap_ordered);
+        EXPECT_EQ(facts.count, 1000);
+
+        // The tree still works afterwards.
+        EXPECT_EQ(bst::remove_if(root, [](int v) { return v % 2 == 0; }), 500);
+        EXPECT_EQ(bst::destroy(root), 500);
+    }
+
+    TEST(HW09Bulk, RemoveIfThrowingPredicateRetiresFingers)
+    {
+        using Tree = BinarySearchTree<unsigned>;
+        // Even values 0..198 as a valid BST that is not the hashed treap: the treap's
+        // root on top, with a chain down each side. The rebuild keeps the root but
+        // not the shape, so only the new version tells a finger its path is gone.
+        unsigned top = 0;
+        for (unsigned v = 0; v < 200; v += 2) {
+            if (bst::priority(top) < bst::priority(v)) {
+                top = v;
+            }
+        }
+        Tree::Node* root = new Tree::Node(top);
+        Tree::Node* at = root;
+        for (unsigned v = top; v > 0; v -= 2) {
+            at = at->left = new Tree::Node(v - 2);
+        }
+        at = root;
+        for (unsigned v = top + 2; v < 200; v += 2) {
+            at = at->right = new Tree::Node(v);
+        }
+        BinarySearchTreeHarness<unsigned> held(root, 100);
+        Tree& tree = held.tree();
+
+        Tree::Finger finger;
+        ASSERT_TRUE(tree.insert_hint(finger, 101));
+        EXPECT_THROW(tree.remove_if([](unsigned) -> bool { throw std::runtime_error("predicate failed"); }),
+                     std::runtime_error);
+        EXPECT_EQ(held.size(), 101);
+        EXPECT_TRUE(tree.verify(true));
+
+        for (unsigned v = 103; v < 200; v += 4) {
+            ASSERT_TRUE(tree.insert_hint(finger, v));
+        }
+        EXPECT_EQ(held.size(), 126);
+        EXPECT_TRUE(tree.verify(true));
+        std::vector<unsigned> values = held.values();
+        EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+        EXPECT_EQ(values.size(), 126);
+    }
+
+    TEST(HW09Bulk, RemoveBatch)
+    {
+        std::mt19937 rng(21);
+        std::set<int> reference;
+        Node* root = nullptr;
+        for (int i = 0; i < 5000; ++i) {
+            int k = static_cast<int>(rng() % 20000);
+            if (reference.insert(k).second) {
+                bst::insert(root, new Node(k));
+            }
+        }
+
+        std::vector<int> keys;
+        for (int i = 0; i < 3000; ++i) {
+            keys.push_back(static_cast<int>(rng() % 20000));
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        size_t expected_removed = 0;
+        for (int k : keys) {
+            expected_removed += reference.erase(k);
+        }
+        EXPECT_EQ(bst::remove_batch(root, keys.data(), keys.size()), expected_removed);
+
+        std::vector<int> values;
+        collect(root, values);
+        EXPECT_EQ(values, std::vector<int>(reference.begin(), reference.end()));
+        bst::destroy(root);
+    }
+}
@@ -0,0 +1,190 @@
+#include "hw09_compact.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace cppclass
+{
+    TEST(HW09Compact, NodeLayout)
+    {
+        EXPECT_EQ(sizeof(CompactBinarySearchTree<int>::Node), 12);
+    }
+
+    TEST(HW09Compact, MatchesStdSet)
+    {
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> key(0, 1000);
+        std::set<int> reference;
+        CompactBinarySearchTree<int> tree;
+
+        for (int i = 0; i < 30000; ++i) {
+            int k = key(rng);
+            if (rng() % 2 == 0) {
+                ASSERT_EQ(tree.insert(k), reference.insert(k).second);
+            } else {
+                ASSERT_EQ(tree.remove(k), reference.erase(k) == 1);
+            }
+            ASSERT_EQ(tree.size(), reference.size());
+        }
+        for (int k = 0; k <= 1000; ++k) {
+            EXPECT_EQ(tree.contains(k), reference.count(k) == 1);
+        }
+
+        std::vector<int> ordered;
+        tree.for_each([&](int v) { ordered.push_back(v); });
+        EXPECT_EQ(ordered, std::vector<int>(reference.begin(), reference.end()));
+    }
+
+    TEST(HW09Compact, SerializeRoundTrip)
+    {
+        int values[] = {50, 30, 70, 20, 40, 60, 80};
+        CompactBinarySearchTree<int> tree(values, 7);
+        tree.remove(30);
+
+        std::stringstream buffer;
+        ASSERT_TRUE(tree.serialize(buffer));
+        auto loaded = CompactBinarySearchTree<int>::deserialize(buffer);
+
+        EXPECT_TRUE(loaded == tree);
+        EXPECT_EQ(loaded.size(), 6);
+        EXPECT_FALSE(loaded.contains(30));
+
+        // The free list survives the round trip, so the freed slot is reused.
+        EXPECT_TRUE(loaded.insert(35));
+        EXPECT_TRUE(loaded.contains(35));
+        EXPECT_TRUE(loaded != tree);
+
+        std::stringstream truncated(buffer.str().substr(0, 10));
+        EXPECT_THROW(CompactBinarySearchTree<int>::deserialize(truncated), std::runtime_error);
+    }
+
+    // Serializes a small tree, lets @p corrupt patch the raw bytes, and reads it back.
+    template <typename Corrupt>
+    static void expect_rejected(Corrupt corrupt)
+    {
+        int values[] = {50, 30, 70, 20, 40, 60, 80};
+        CompactBinarySearchTree<int> tree(values, 7);
+        tree.remove(30);
+        std::stringstream buffer;
+        ASSERT_TRUE(tree.serialize(buffer));
+        std::string bytes = buffer.str();
+        uint64_t header[4];
+        std::memcpy(header, bytes.data(), sizeof(header));
+        using Node = CompactBinarySearchTree<int>::Node;
+        std::vector<Node> nodes(header[0]);
+        std::memcpy(nodes.data(), bytes.data() + sizeof(header), nodes.size() * sizeof(Node));
+
+        corrupt(header, nodes);
+
+        std::string patched(reinterpret_cast<const char*>(header), sizeof(header));
+        patched.append(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(Node));
+        std::stringstream in(patched);
+        EXPECT_THROW(CompactBinarySearchTree<int>::deserialize(in), std::runtime_error);
+    }
+
+    TEST(HW09Compact, DeserializeRejectsCorruptData)
+    {
+        using Node = CompactBinarySearchTree<int>::Node;
+        using Index = CompactBinarySearchTree<int>::Index;
+        // Root or free list out of range.
+        expect_rejected([](uint64_t* header, std::vector<Node>&) { header[2] = 1000; });
+        expect_rejected([](uint64_t* header, std::vector<Node>&) { header[3] = 7; });
+        // A child index out of range.
+        expect_rejected([](uint64_t* header, std::vector<Node>& nodes) {
+            Index leaf = static_cast<Index>(header[2]);
+            while (nodes[leaf].left != CompactBinarySearchTree<int>::npos) {
+                leaf = nodes[leaf].left;
+            }
+            nodes[leaf].left = 12345;
+        });
+        // A cycle back to the root.
+        expect_rejected([](uint64_t* header, std::vector<Node>& nodes) {
+            Index at = static_cast<Index>(header[2]);
+            while (nodes[at].right != CompactBinarySearchTree<int>::npos) {
+                at = nodes[at].right;
+            }
+            nodes[at].right = static_cast<Index>(header[2]);
+        });
+        // Values out of order.
+        expect_rejected([](uint64_t* header, std::vector<Node>& nodes) {
+            nodes[header[2]].data = -1;
+        });
+        // Size disagreeing with the reachable nodes.
+        expect_rejected([](uint64_t* header, std::vector<Node>&) { header[1] = 5; });
+        // Free slot leaked: neither reachable nor on the free list.
+        expect_rejected([](uint64_t* header, std::vector<Node>&) {
+            header[3] = CompactBinarySearchTree<int>::npos;
+        });
+    }
+
+    TEST(HW09Compact, DeserializeDoesNotTrustNodeCount)
+    {
+        // A bare header claiming about 4G nodes fails at end of stream, not in the allocator.
+        uint64_t header[4] = {CompactBinarySearchTree<int>::npos - 1, 0, CompactBinarySearchTree<int>::npos,
+                              CompactBinarySearchTree<int>::npos};
+        std::stringstream in(std::string(reinterpret_cast<const char*>(header), sizeof(header)));
+        EXPECT_THROW(CompactBinarySearchTree<int>::deserialize(in), std::runtime_error);
+    }
+
+    // Reads back the node array serialize() writes: header, then the nodes.
+    static std::vector<CompactBinarySearchTree<int>::Node> raw_nodes(const CompactBinarySearchTree<int>& tree,
+                                                                     uint64_t* header)
+    {
+        std::stringstream buffer;
+        tree.serialize(buffer);
+        std::string bytes = buffer.str();
+        std::memcpy(header, bytes.data(), 4 * sizeof(uint64_t));
+        std::vector<CompactBinarySearchTree<int>::Node> nodes(header[0]);
+        std::memcpy(nodes.data(), bytes.data() + 4 * sizeof(uint64_t),
+                    nodes.size() * sizeof(CompactBinarySearchTree<int>::Node));
+        return nodes;
+    }
+
+    TEST(HW09Compact, SortedInsertStaysBalanced)
+    {
+        using Index = CompactBinarySearchTree<int>::Index;
+        CompactBinarySearchTree<int> tree;
+        for (int i = 0; i < 200000; i += 2) {
+            ASSERT_TRUE(tree.insert(i));
+        }
+        for (int i = 0; i < 200000; i += 6) {
+            ASSERT_TRUE(tree.remove(i));
+        }
+        EXPECT_FALSE(tree.insert(2));
+        EXPECT_TRUE(tree.contains(4));
+        EXPECT_FALSE(tree.contains(6));
+
+        uint64_t header[4];
+        auto nodes = raw_nodes(tree, header);
+        std::vector<std::pair<Index, size_t>> stack{{static_cast<Index>(header[2]), 1}};
+        size_t height = 0;
+        while (!stack.empty()) {
+            auto [at, depth] = stack.back();
+            stack.pop_back();
+            height = std::max(height, depth);
+            for (Index child : {nodes[at].left, nodes[at].right}) {
+                if (child != CompactBinarySearchTree<int>::npos) {
+                    EXPECT_FALSE(bst::priority(nodes[at].data) < bst::priority(nodes[child].data));
+                    stack.push_back({child, depth + 1});
+                }
+            }
+        }
+        EXPECT_LT(height, 80);
+    }
+
+    TEST(HW09Compact, FreedSlotsAreCleared)
+    {
+        int values[] = {50, 30, 70};
+        CompactBinarySearchTree<int> tree(values, 3);
+        tree.remove(30);
+        uint64_t header[4];
+        auto nodes = raw_nodes(tree, header);
+        ASSERT_NE(header[3], CompactBinarySearchTree<int>::npos);
+        EXPECT_EQ(nodes[header[3]].data, 0);
+    }
+}
@@ -0,0 +1,90 @@
+#include "hw09.h"
+#include "gtest/gtest.h"
+#include <sstream>
+#include <string>
+
+namespace cppclass
+{
+    using Node = BinarySearchTree<int>::Node;
+
+    // The tree drawn in example_05/bst.txt.
+    static Node* example_tree()
+    {
+        Node* root = new Node(100);
+        root->left = new Node(40);
+        root->left->left = new Node(10);
+        root->left->right = new Node(60);
+        root->right = new Node(200);
+        root->right->left = new Node(170);
+        root->right->right = new Node(250);
+        root->right->right->right = new Node(300);
+        return root;
+    }
+
+    TEST(HW09Dump, InOrder)
+    {
+        Node* root = example_tree();
+        std::ostringstream out;
+        {
+            bst::Sink sink(out);
+            bst::dump_in_order(root, sink);
+        }
+        EXPECT_EQ(out.str(), "10 40 60 100 170 200 250 300\n");
+        bst::destroy(root);
+    }
+
+    TEST(HW09Dump, LevelOrder)
+    {
+        Node* root = example_tree();
+        std::ostringstream out;
+        {
+            bst::Sink sink(out);
+            bst::dump_level_order(root, sink);
+        }
+        EXPECT_EQ(out.str(), "100\n40 200\n10 60 170 250\n300\n");
+        bst::destroy(root);
+    }
+
+    TEST(HW09Dump, Sideways)
+    {
+        Node* root = example_tree();
+        std::ostringstream out;
+        {
+            bst::Sink sink(out);
+            bst::dump_sideways(root, sink);
+        }
+        EXPECT_EQ(out.str(),
+                  "            300\n"
+                  "        250\n"
+                  "    200\n"
+                  "        170\n"
+                  "100\n"
+                  "        60\n"
+                  "    40\n"
+                  "        10\n");
+        bst::destroy(root);
+    }
+
+    TEST(HW09Dump, SinkBuffersAndFormats)
+    {
+        std::ostringstream out;
+        {
+            bst::Sink sink(out, 64);
+            for (int i = 0; i < 100; ++i) {
+                sink.value(i);
+                sink.put(',');
+            }
+            sink.value(2.5);
+            sink.put(',');
+            sink.value(std::string("text"));
+            // Nothing reaches the stream until the buffer fills or is flushed.
+            EXPECT_LT(out.str().size(), 300u);
+        }
+        std::string expected;
+        for (int i = 0; i < 100; ++i) {
+            expected += std::to_string(i) + ",";
+        }
+        expected += "2.5,text";
+        EXPECT_EQ(out.str(), expected);
+    }
+}
@@ -0,0 +1,182 @@
+#include "hw09.h"
+#include "bst_harness.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace cppclass
+{
+    using Node = BinarySearchTree<int>::Node;
+    using Finger = BinarySearchTree<int>::Finger;
+
+    static bool same_shape(const Node* a, const Node* b)
+    {
+        if (a == nullptr || b == nullptr) {
+            return a == b;
+        }
+        return a->data == b->data && same_shape(a->left, b->left) && same_shape(a->right, b->right);
+    }
+
+    TEST(HW09Finger, SortedStreamBuildsTheTreap)
+    {
+        Node* hinted = nullptr;
+        Node* plain = nullptr;
+        Finger finger;
+        size_t steps = 0;
+        for (int i = 0; i < 100000; ++i) {
+            ASSERT_TRUE(bst::insert_hint(hinted, finger, new Node(i)));
+            EXPECT_EQ(finger.node()->data, i);
+            steps += finger.steps();
+            bst::insert(plain, new Node(i));
+        }
+        // One step per insert: the finger already sits on the parent of the new leaf.
+        EXPECT_LE(steps, 100000u);
+
+        bst::Verification facts = bst::verify(hinted, 0);
+        EXPECT_TRUE(facts.ordered);
+        EXPECT_TRUE(facts.heap_ordered);
+        EXPECT_EQ(facts.count, 100000);
+        EXPECT_LT(facts.height, 80);
+        EXPECT_TRUE(same_shape(hinted, plain));
+        bst::destroy(hinted);
+        bst::destroy(plain);
+    }
+
+    TEST(HW09Finger, NearlySortedStream)
+    {
+        std::vector<int> values(50000);
+        std::iota(values.begin(), values.end(), 0);
+        std::mt19937 rng(11);
+        for (size_t i = 0; i + 8 < values.size(); i += 8) {
+            std::shuffle(values.begin() + i, values.begin() + i + 8, rng);
+        }
+
+        Node* root = nullptr;
+        Finger finger;
+        size_t steps = 0;
+        for (int v : values) {
+            ASSERT_TRUE(bst::insert_hint(root, finger, new Node(v)));
+            steps += finger.steps();
+        }
+        EXPECT_LT(steps, 20 * values.size());
+
+        bst::Verification facts = bst::verify(root, 0);
+        EXPECT_TRUE(facts.ordered);
+        EXPECT_TRUE(facts.heap_ordered);
+        EXPECT_EQ(facts.count, values.size());
+        bst::destroy(root);
+    }
+
+    TEST(HW09Finger, MatchesStdSetOnRandomInput)
+    {
+        Node* root = nullptr;
+        Finger finger;
+        std::set<int> model;
+        std::mt19937 rng(2);
+        std::uniform_int_distribution<int> value(0, 2000);
+        for (int i = 0; i < 5000; ++i) {
+            int v = value(rng);
+            Node* node = new Node(v);
+            bool inserted = bst::insert_hint(root, finger, node);
+            ASSERT_EQ(inserted, model.insert(v).second);
+            if (!inserted) {
+                delete node;
+            }
+            ASSERT_NE(finger.node(), nullptr);
+            EXPECT_EQ(finger.node()->data, v);
+        }
+        for (int v = 0; v <= 2000; ++v) {
+            Node* found = bst::find_hint(root, finger, v);
+            EXPECT_EQ(found != nullptr, model.count(v) > 0);
+            EXPECT_EQ(found, bst::find(root, v));
+        }
+        bst::Verification facts = bst::verify(root, 0);
+        EXPECT_TRUE(facts.ordered);
+        EXPECT_TRUE(facts.heap_ordered);
+        EXPECT_EQ(facts.count, model.size());
+        bst::destroy(root);
+    }
+
+    TEST(HW09Finger, RestartsWhenRootChanges)
+    {
+        Node* root = nullptr;
+        Finger finger;
+        for (int i = 0; i < 100; ++i) {
+            bst::insert_hint(root, finger, new Node(i));
+        }
+        // Changes made without the finger: erase may replace the root.
+        bst::erase(root, root->data);
+        finger.reset();
+        EXPECT_EQ(bst::find_hint(root, finger, 50) != nullptr, bst::find(root, 50) != nullptr);
+
+        Node* other = nullptr;
+        for (int i = 200; i < 300; ++i) {
+            bst::insert(other, new Node(i));
+        }
+        // A finger left on another tree is noticed through the root.
+        EXPECT_EQ(bst::find_hint(other, finger, 250), bst::find(other, 250));
+        EXPECT_TRUE(bst::insert_hint(other, finger, new Node(300)));
+        EXPECT_TRUE(bst::verify(other, 0).heap_ordered);
+        bst::destroy(root);
+        bst::destroy(other);
+    }
+
+    TEST(HW09Finger, TreeVersionRetiresStaleFingers)
+    {
+        BinarySearchTreeHarness<unsigned> held;
+        BinarySearchTree<unsigned>& tree = held.tree();
+        BinarySearchTree<unsigned>::Finger finger;
+        for (unsigned i = 0; i < 100; ++i) {
+            ASSERT_TRUE(tree.insert_hint(finger, i));
+        }
+        // The finger sits on 99, which is freed here while the root may well survive.
+        EXPECT_EQ(tree.remove_if([](unsigned v) { return v >= 50; }), 50);
+        EXPECT_TRUE(tree.insert_hint(finger, 99));
+        EXPECT_FALSE(tree.insert_hint(finger, 10));
+        EXPECT_EQ(held.size(), 51);
+        EXPECT_TRUE(tree.verify(true));
+
+        // A finger carried over to another tree, or across a swap, restarts too.
+        BinarySearchTreeHarness<unsigned> other_held;
+        BinarySearchTree<unsigned>& other = other_held.tree();
+        BinarySearchTree<unsigned>::Finger other_finger;
+        for (unsigned i = 1000; i < 1100; ++i) {
+            ASSERT_TRUE(other.insert_hint(other_finger, i));
+        }
+        EXPECT_TRUE(other.insert_hint(finger, 500));
+        tree.swap(other);
+        EXPECT_TRUE(tree.insert_hint(other_finger, 1100));
+        EXPECT_TRUE(other.insert_hint(other_finger, 100));
+        EXPECT_TRUE(tree.verify(true));
+        EXPECT_TRUE(other.verify(true));
+        EXPECT_EQ(held.size(), 102);
+        EXPECT_EQ(other_held.size(), 52);
+    }
+
+    TEST(HW09Finger, TreeSizeRetiresFingersAfterUnversionedChanges)
+    {
+        BinarySearchTreeHarness<unsigned> held;
+        BinarySearchTree<unsigned>& tree = held.tree();
+        BinarySearchTree<unsigned>::Finger finger;
+        for (unsigned i = 0; i < 100; ++i) {
+            ASSERT_TRUE(tree.insert_hint(finger, i));
+        }
+        // The finger sits on 99. This removal keeps the version, and the root
+        // survives, so only the size tells the finger that 99 is gone.
+        unsigned root_value = 0; // The treap root holds the highest priority.
+        tree.for_each([&](unsigned v) {
+            if (bst::priority(root_value) < bst::priority(v)) {
+                root_value = v;
+            }
+        });
+        ASSERT_NE(root_value, 99u);
+        ASSERT_TRUE(held.remove(99));
+        EXPECT_TRUE(tree.insert_hint(finger, 100));
+        EXPECT_TRUE(tree.insert_hint(finger, 99));
+        EXPECT_EQ(held.size(), 101);
+        EXPECT_TRUE(tree.verify(true));
+    }
+}
@@ -0,0 +1,167 @@
+#include "hw09_compact.h"
+#include "hw09_flat_hash.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace cppclass
+{
+    // Every value hashes alike, so all of them share one probe sequence.
+    struct Colliding
+    {
+        int value;
+        bool operator==(const Colliding& other) const { return value == other.value; }
+    };
+}
+
+template <>
+struct std::hash<cppclass::Colliding>
+{
+    size_t operator()(const cppclass::Colliding&) const { return 42; }
+};
+
+namespace cppclass
+{
+    static_assert(std::is_nothrow_move_constructible_v<FlatHashSet<int>>);
+    static_assert(std::is_nothrow_move_assignable_v<FlatHashSet<int>>);
+
+    TEST(HW09FlatHash, InsertContainsRemove)
+    {
+        FlatHashSet<int> set;
+        EXPECT_EQ(set.size(), 0);
+        EXPECT_EQ(set.capacity(), 0);
+        EXPECT_FALSE(set.contains(1));
+        EXPECT_FALSE(set.remove(1));
+
+        EXPECT_TRUE(set.insert(5));
+        EXPECT_TRUE(set.insert(3));
+        EXPECT_TRUE(set.insert(8));
+        EXPECT_FALSE(set.insert(3));
+        EXPECT_EQ(set.size(), 3);
+        EXPECT_EQ(set.capacity() % 16, 0);
+
+        EXPECT_TRUE(set.contains(3));
+        EXPECT_TRUE(set.contains(8));
+        EXPECT_FALSE(set.contains(4));
+
+        EXPECT_TRUE(set.remove(5));
+        EXPECT_FALSE(set.contains(5));
+        EXPECT_FALSE(set.remove(5));
+        EXPECT_EQ(set.size(), 2);
+    }
+
+    // The same calls work on the trees, so a type alias can pick either.
+    template <typename Set>
+    static void check_against_std_set()
+    {
+        Set set;
+        std::set<int> model;
+        std::mt19937 rng(5);
+        std::uniform_int_distribution<int> value(-3000, 3000);
+        for (int i = 0; i < 60000; ++i) {
+            int v = value(rng);
+            switch (rng() % 3) {
+            case 0:
+                ASSERT_EQ(set.insert(v), model.insert(v).second);
+                break;
+            case 1:
+                ASSERT_EQ(set.remove(v), model.erase(v) > 0);
+                break;
+            default:
+                ASSERT_EQ(set.contains(v), model.count(v) > 0);
+                break;
+            }
+        }
+        EXPECT_EQ(set.size(), model.size());
+        Set copy = set;
+        EXPECT_TRUE(copy == set);
+        copy.remove(*model.begin());
+        EXPECT_TRUE(copy != set);
+    }
+
+    TEST(HW09FlatHash, MatchesStdSet)
+    {
+        check_against_std_set<FlatHashSet<int>>();
+        check_against_std_set<CompactBinarySearchTree<int>>();
+    }
+
+    TEST(HW09FlatHash, TombstonesDoNotGrowTable)
+    {
+        FlatHashSet<int> set;
+        for (int i = 0; i < 100; ++i) {
+            set.insert(i);
+        }
+        size_t capacity = set.capacity();
+        for (int round = 1; round < 1000; ++round) {
+            ASSERT_TRUE(set.remove(round - 1));
+            ASSERT_TRUE(set.insert(round + 99));
+        }
+        EXPECT_EQ(set.size(), 100);
+        EXPECT_EQ(set.capacity(), capacity);
+        for (int i = 999; i < 1099; ++i) {
+            EXPECT_TRUE(set.contains(i));
+        }
+        EXPECT_FALSE(set.contains(998));
+    }
+
+    TEST(HW09FlatHash, CollidingHashesProbeAcrossGroups)
+    {
+        FlatHashSet<Colliding> set;
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_TRUE(set.insert({i}));
+        }
+        EXPECT_FALSE(set.insert({50}));
+        for (int i = 0; i < 100; i += 2) {
+            EXPECT_TRUE(set.remove({i}));
+        }
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_EQ(set.contains({i}), i % 2 == 1) << i;
+        }
+    }
+
+    TEST(HW09FlatHash, OwnsNonTrivialValues)
+    {
+        FlatHashSet<std::string> set;
+        std::vector<std::string> words;
+        for (int i = 0; i < 1000; ++i) {
+            words.push_back("a fairly long word number " + std::to_string(i));
+            set.insert(words.back());
+        }
+        for (int i = 0; i < 1000; i += 3) {
+            set.remove(words[i]);
+        }
+        FlatHashSet<std::string> moved = std::move(set);
+        EXPECT_EQ(set.size(), 0);
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(moved.contains(words[i]), i % 3 != 0);
+        }
+        set = moved;
+        EXPECT_TRUE(set == moved);
+        set.clear();
+        EXPECT_EQ(set.size(), 0);
+        EXPECT_FALSE(set.contains(words[1]));
+    }
+
+    TEST(HW09FlatHash, ForEachVisitsEveryValueOnce)
+    {
+        int values[] = {9, 4, 7, 1, 12};
+        FlatHashSet<int> set(values, 5);
+        std::multiset<int> seen;
+        set.for_each([&](int v) { seen.insert(v); });
+        EXPECT_EQ(seen, (std::multiset<int>{1, 4, 7, 9, 12}));
+    }
+
+    TEST(HW09FlatHash, ReserveAvoidsRehash)
+    {
+        FlatHashSet<int> set;
+        set.reserve(1000);
+        size_t capacity = set.capacity();
+        EXPECT_GE(capacity - capacity / 8, 1000);
+        for (int i = 0; i < 1000; ++i) {
+            set.insert(i);
+        }
+        EXPECT_EQ(set.capacity(), capacity);
+    }
+}
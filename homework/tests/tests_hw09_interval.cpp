@@ -0,0 +1,131 @@
+#include "hw09_interval.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace cppclass
+{
+    TEST(HW09Interval, Basic)
+    {
+        IntervalTree<int> tree;
+        EXPECT_TRUE(tree.insert(15, 20));
+        EXPECT_TRUE(tree.insert(10, 30));
+        EXPECT_TRUE(tree.insert(17, 19));
+        EXPECT_TRUE(tree.insert(5, 20));
+        EXPECT_TRUE(tree.insert(12, 15));
+        EXPECT_TRUE(tree.insert(30, 40));
+        EXPECT_FALSE(tree.insert(12, 15));
+        EXPECT_EQ(tree.size(), 6);
+
+        auto hits = tree.overlapping(6, 7);
+        ASSERT_EQ(hits.size(), 1);
+        EXPECT_EQ(hits[0].low, 5);
+        EXPECT_EQ(hits[0].high, 20);
+
+        hits = tree.overlapping(30, 30);
+        ASSERT_EQ(hits.size(), 2);
+        std::sort(hits.begin(), hits.end(), [](const auto& a, const auto& b) { return a.low < b.low; });
+        EXPECT_EQ(hits[0].low, 10);
+        EXPECT_EQ(hits[1].low, 30);
+
+        EXPECT_TRUE(tree.overlapping(41, 50).empty());
+        EXPECT_TRUE(tree.overlapping(0, 4).empty());
+
+        EXPECT_TRUE(tree.remove(10, 30));
+        EXPECT_FALSE(tree.remove(10, 30));
+        EXPECT_FALSE(tree.contains(10, 30));
+        EXPECT_TRUE(tree.contains(17, 19));
+        EXPECT_EQ(tree.overlapping(25, 29).size(), 0);
+        EXPECT_EQ(tree.size(), 5);
+    }
+
+    TEST(HW09Interval, MatchesBruteForce)
+    {
+        std::mt19937 rng(5);
+        std::uniform_int_distribution<int> start(0, 10000);
+        std::uniform_int_distribution<int> length(0, 300);
+        std::set<std::pair<int, int>> reference;
+        IntervalTree<int> tree;
+
+        for (int i = 0; i < 4000; ++i) {
+            int lo = start(rng);
+            int hi = lo + length(rng);
+            EXPECT_EQ(tree.insert(lo, hi), reference.insert({lo, hi}).second);
+        }
+        std::vector<std::pair<int, int>> victims(reference.begin(), reference.end());
+        std::shuffle(victims.begin(), victims.end(), rng);
+        victims.resize(victims.size() / 3);
+        for (auto [lo, hi] : victims) {
+            EXPECT_TRUE(tree.remove(lo, hi));
+            reference.erase({lo, hi});
+        }
+        ASSERT_EQ(tree.size(), reference.size());
+
+        for (int q = 0; q < 200; ++q) {
+            int lo = start(rng);
+            int hi = lo + length(rng);
+            std::vector<std::pair<int, int>> expected;
+            for (auto [a, b] : reference) {
+                if (a <= hi && lo <= b) {
+                    expected.push_back({a, b});
+                }
+            }
+            std::vector<std::pair<int, int>> actual;
+            tree.overlapping(lo, hi, [&](const IntervalTree<int>::Interval& iv) {
+                actual.push_back({iv.low, iv.high});
+            });
+            std::sort(actual.begin(), actual.end());
+            EXPECT_EQ(actual, expected);
+        }
+
+        // Removing everything must leave no interval behind in a slot.
+        for (auto [lo, hi] : reference) {
+            EXPECT_TRUE(tree.remove(lo, hi));
+        }
+        EXPECT_EQ(tree.size(), 0);
+        EXPECT_TRUE(tree.overlapping(0, 20000).empty());
+    }
+
+    TEST(HW09Interval, QueryCostIsLogPlusOutput)
+    {
+        // Sorted short intervals, nested intervals and random ones; the nested set is the
+        // case where a subtree-maximum tree checks many intervals on each root path.
+        const int n = 1 << 15;
+        for (int shape = 0; shape < 3; ++shape) {
+            std::mt19937 rng(7);
+            IntervalTree<int> tree;
+            for (int i = 0; i < n; ++i) {
+                int lo = shape == 2 ? static_cast<int>(rng() % (4 * n)) : i;
+                int hi = shape == 0 ? i + 10 : shape == 1 ? 2 * n - i : lo + static_cast<int>(rng() % 64);
+                tree.insert(lo, hi);
+            }
+            for (int q = 0; q < 500; ++q) {
+                int lo = static_cast<int>(rng() % (4 * n));
+                int hi = lo + static_cast<int>(rng() % 200);
+                size_t hits = 0;
+                size_t examined = tree.overlapping(lo, hi, [&](const IntervalTree<int>::Interval&) { ++hits; });
+                EXPECT_LE(examined, 4 * (std::log2(n) + hits)) << "shape " << shape << " query " << lo;
+            }
+        }
+    }
+
+    TEST(HW09Interval, RejectsReversedIntervals)
+    {
+        IntervalTree<int> tree;
+        EXPECT_TRUE(tree.insert(1, 5));
+        EXPECT_TRUE(tree.insert(3, 3));
+        EXPECT_THROW(tree.insert(5, 1), std::invalid_argument);
+        EXPECT_EQ(tree.size(), 2);
+        EXPECT_FALSE(tree.contains(5, 1));
+        EXPECT_FALSE(tree.remove(5, 1));
+
+        EXPECT_THROW(tree.overlapping(4, 2), std::invalid_argument);
+        EXPECT_THROW(tree.overlapping(4, 2, [](const IntervalTree<int>::Interval&) {}), std::invalid_argument);
+        EXPECT_EQ(tree.overlapping(3, 3).size(), 2);
+    }
+}
@@ -0,0 +1,268 @@
+#include "hw09.h"
+#include "bst_harness.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace cppclass
+{
+    using Node = BinarySearchTree<int>::Node;
+
+    static Node* build(const std::vector<int>& values)
+    {
+        Node* root = nullptr;
+        for (int v : values) {
+            Node* node = new Node(v);
+            if (!bst::insert(root, node)) {
+                delete node;
+            }
+        }
+        return root;
+    }
+
+    static void collect(const Node* root, std::vector<int>& out)
+    {
+        if (root == nullptr) {
+            return;
+        }
+        collect(root->left, out);
+        out.push_back(root->data);
+        collect(root->right, out);
+    }
+
+    static std::vector<int> random_keys(size_t count, int range, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> dist(0, range);
+        std::vector<int> keys(count);
+        for (auto& k : keys) {
+            k = dist(rng);
+        }
+        return keys;
+    }
+
+    static std::vector<int> sorted_unique(std::vector<int> keys)
+    {
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        return keys;
+    }
+
+    TEST(HW09Join, SplitAndJoin)
+    {
+        Node* root = build({50, 20, 80, 10, 30, 70, 90});
+        Node* left;
+        Node* right;
+
+        Node* mid = bst::split(root, 30, left, right);
+        ASSERT_NE(mid, nullptr);
+        EXPECT_EQ(mid->data, 30);
+
+        std::vector<int> l, r;
+        collect(left, l);
+        collect(right, r);
+        EXPECT_EQ(l, (std::vector<int>{10, 20}));
+        EXPECT_EQ(r, (std::vector<int>{50, 70, 80, 90}));
+
+        root = bst::join(left, mid, right);
+        std::vector<int> all;
+        collect(root, all);
+        EXPECT_EQ(all, (std::vector<int>{10, 20, 30, 50, 70, 80, 90}));
+
+        EXPECT_EQ(bst::split(root, 40, left, right), nullptr);
+        root = bst::join2(left, right);
+        EXPECT_EQ(bst::destroy(root), 7);
+    }
+
+    TEST(HW09Join, InsertErase)
+    {
+        Node* root = build({5, 3, 8});
+        Node* dup = new Node(3);
+        EXPECT_FALSE(bst::insert(root, dup));
+        delete dup;
+
+        EXPECT_TRUE(bst::erase(root, 3));
+        EXPECT_FALSE(bst::erase(root, 3));
+        EXPECT_EQ(bst::find(root, 3), nullptr);
+        EXPECT_NE(bst::find(root, 8), nullptr);
+        EXPECT_EQ(bst::destroy(root), 2);
+    }
+
+    TEST(HW09Join, PrimitivesHandleDegenerateTrees)
+    {
+        // A plain BST fed sorted input: one long right spine, far deeper than the stack allows to recurse.
+        const int n = 1000000;
+        Node* root = nullptr;
+        Node** tail = &root;
+        for (int i = 0; i < n; ++i) {
+            *tail = new Node(i);
+            tail = &(*tail)->right;
+        }
+
+        Node* left;
+        Node* right;
+        Node* mid = bst::split(root, n / 2, left, right);
+        ASSERT_NE(mid, nullptr);
+        EXPECT_EQ(mid->data, n / 2);
+        EXPECT_EQ(bst::find(left, n / 2 - 1)->data, n / 2 - 1);
+        EXPECT_EQ(bst::find(right, n / 2 + 1)->data, n / 2 + 1);
+        EXPECT_EQ(bst::find(right, n / 2 - 1), nullptr);
+
+        root = bst::join(left, mid, right);
+        EXPECT_TRUE(bst::erase(root, n - 1));
+        EXPECT_TRUE(bst::insert(root, new Node(n)));
+        root = bst::join2(root, static_cast<Node*>(nullptr));
+        bst::Verification facts = bst::verify(root, 0);
+        EXPECT_TRUE(facts.ordered);
+        EXPECT_EQ(facts.count, static_cast<size_t>(n));
+        EXPECT_EQ(bst::destroy(root), static_cast<size_t>(n));
+    }
+
+    TEST(HW09Join, SetOperations)
+    {
+        for (unsigned fork_depth : {0u, 3u}) {
+            auto a_keys = sorted_unique(random_keys(3000, 5000, 1));
+            auto b_keys = sorted_unique(random_keys(500, 5000, 2));
+
+            std::vector<int> expected;
+            std::vector<int> actual;
+
+            {
+                std::set_union(a_keys.begin(), a_keys.end(), b_keys.begin(), b_keys.end(),
+                               std::back_inserter(expected));
+                auto [root, dropped] = bst::set_union(build(a_keys), build(b_keys), fork_depth);
+                collect(root, actual);
+                EXPECT_EQ(actual, expected);
+                EXPECT_EQ(a_keys.size() + b_keys.size() - dropped, expected.size());
+                bst::destroy(root);
+            }
+
+            expected.clear();
+            actual.clear();
+            {
+                std::set_intersection(a_keys.begin(), a_keys.end(), b_keys.begin(), b_keys.end(),
+                                      std::back_inserter(expected));
+                auto [root, dropped] = bst::set_intersection(build(a_keys), build(b_keys), fork_depth);
+                collect(root, actual);
+                EXPECT_EQ(actual, expected);
+                EXPECT_EQ(a_keys.size() + b_keys.size() - dropped, expected.size());
+                bst::destroy(root);
+            }
+
+            expected.clear();
+            actual.clear();
+            {
+                std::set_difference(a_keys.begin(), a_keys.end(), b_keys.begin(), b_keys.end(),
+                                    std::back_inserter(expected));
+                auto [root, dropped] = bst::set_difference(build(a_keys), build(b_keys), fork_depth);
+                collect(root, actual);
+                EXPECT_EQ(actual, expected);
+                EXPECT_EQ(a_keys.size() + b_keys.size() - dropped, expected.size());
+                bst::destroy(root);
+            }
+        }
+    }
+
+    TEST(HW09Join, EmptyOperands)
+    {
+        auto [u, u_dropped] = bst::set_union(build({1, 2}), static_cast<Node*>(nullptr));
+        EXPECT_EQ(u_dropped, 0);
+        auto [i, i_dropped] = bst::set_intersection(u, static_cast<Node*>(nullptr));
+        EXPECT_EQ(i, nullptr);
+        EXPECT_EQ(i_dropped, 2);
+        auto [d, d_dropped] = bst::set_difference(static_cast<Node*>(nullptr), build({3}));
+        EXPECT_EQ(d, nullptr);
+        EXPECT_EQ(d_dropped, 1);
+    }
+
+    using Harness = BinarySearchTreeHarness<long>;
+    using LongTree = BinarySearchTree<long>;
+
+    TEST(HW09Join, TreeSetOperations)
+    {
+        std::vector<long> a_keys;
+        std::vector<long> b_keys;
+        for (long i = 0; i < 2000; ++i) {
+            a_keys.push_back(i * 3);
+            b_keys.push_back(i * 5);
+        }
+        std::vector<long> expected;
+
+        {
+            Harness a(a_keys);
+            Harness b(b_keys);
+            Harness joined([&] { return LongTree::set_union(std::move(a.tree()), std::move(b.tree())); });
+            std::set_union(a_keys.begin(), a_keys.end(), b_keys.begin(), b_keys.end(),
+                           std::back_inserter(expected));
+            EXPECT_EQ(joined.values(), expected);
+            // Duplicates were freed, so the size is below the sum of the inputs.
+            EXPECT_EQ(joined.size(), expected.size());
+            EXPECT_TRUE(joined.tree().verify(true));
+            EXPECT_EQ(a.size(), 0);
+            EXPECT_EQ(b.size(), 0);
+            EXPECT_TRUE(a.tree().verify());
+        }
+
+        expected.clear();
+        Harness a(a_keys);
+        Harness b(b_keys);
+        Harness common([&] { return LongTree::set_intersection(std::move(a.tree()), std::move(b.tree())); });
+        std::set_intersection(a_keys.begin(), a_keys.end(), b_keys.begin(), b_keys.end(),
+                              std::back_inserter(expected));
+        EXPECT_EQ(common.values(), expected);
+        EXPECT_EQ(common.size(), expected.size());
+        EXPECT_TRUE(common.tree().verify(true));
+
+        expected.clear();
+        Harness again(a_keys);
+        Harness rest([&] { return LongTree::set_difference(std::move(again.tree()), std::move(common.tree())); });
+        std::set_difference(a_keys.begin(), a_keys.end(), b_keys.begin(), b_keys.end(),
+                            std::back_inserter(expected));
+        EXPECT_EQ(rest.values(), expected);
+        EXPECT_EQ(rest.size(), expected.size());
+        EXPECT_TRUE(rest.tree().verify(true));
+        EXPECT_EQ(common.size(), 0);
+
+        // Disjoint and empty operands.
+        Harness pair({1, 2});
+        Harness empty;
+        Harness same([&] { return LongTree::set_union(std::move(pair.tree()), std::move(empty.tree())); });
+        EXPECT_EQ(same.size(), 2);
+        Harness other({3, 4});
+        Harness none([&] { return LongTree::set_intersection(std::move(same.tree()), std::move(other.tree())); });
+        EXPECT_EQ(none.size(), 0);
+        EXPECT_TRUE(none.tree().verify());
+    }
+
+    TEST(HW09Join, TreeSetOperationsOnOneTree)
+    {
+        const std::vector<long> keys{5, 1, 9, 3, 7};
+        const std::vector<long> sorted{1, 3, 5, 7, 9};
+
+        Harness a(keys);
+        Harness u([&] { return LongTree::set_union(std::move(a.tree()), std::move(a.tree())); });
+        EXPECT_EQ(u.values(), sorted);
+        EXPECT_EQ(u.size(), keys.size());
+        EXPECT_TRUE(u.tree().verify(true));
+        EXPECT_EQ(a.size(), 0);
+        EXPECT_TRUE(a.tree().verify());
+
+        Harness b(keys);
+        Harness i([&] { return LongTree::set_intersection(std::move(b.tree()), std::move(b.tree())); });
+        EXPECT_EQ(i.values(), sorted);
+        EXPECT_EQ(i.size(), keys.size());
+        EXPECT_TRUE(i.tree().verify(true));
+        EXPECT_EQ(b.size(), 0);
+
+        // The nodes are freed here; the sanitizer builds would report a leak or a double free.
+        Harness c(keys);
+        Harness d([&] { return LongTree::set_difference(std::move(c.tree()), std::move(c.tree())); });
+        EXPECT_EQ(d.size(), 0);
+        EXPECT_TRUE(d.values().empty());
+        EXPECT_TRUE(d.tree().verify());
+        EXPECT_EQ(c.size(), 0);
+        EXPECT_TRUE(c.tree().verify());
+    }
+}
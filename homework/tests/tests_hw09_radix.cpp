@@ -0,0 +1,183 @@
+#include "alloc_tracker.h"
+#include "hw09.h"
+#include "hw09_radix.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace cppclass
+{
+    static std::string random_url(std::mt19937& rng)
+    {
+        static const char* hosts[] = {"https://example.com/", "https://example.org/", "http://a.io/"};
+        std::uniform_int_distribution<int> host(0, 2);
+        std::uniform_int_distribution<int> length(0, 12);
+        std::uniform_int_distribution<int> letter('a', 'd');
+        std::string url = hosts[host(rng)];
+        for (int i = length(rng); i > 0; --i) {
+            url.push_back(static_cast<char>(letter(rng)));
+        }
+        return url;
+    }
+
+    TEST(HW09Radix, Basic)
+    {
+        RadixTree<std::string> tree;
+        EXPECT_TRUE(tree.insert("romane"));
+        EXPECT_TRUE(tree.insert("romanus"));
+        EXPECT_TRUE(tree.insert("rom"));
+        EXPECT_TRUE(tree.insert(""));
+        EXPECT_FALSE(tree.insert("rom"));
+        EXPECT_EQ(tree.size(), 4);
+
+        EXPECT_TRUE(tree.contains("rom"));
+        EXPECT_TRUE(tree.contains(""));
+        EXPECT_FALSE(tree.contains("roman"));
+        EXPECT_FALSE(tree.contains("romanes"));
+
+        EXPECT_TRUE(tree.remove("rom"));
+        EXPECT_FALSE(tree.remove("rom"));
+        EXPECT_TRUE(tree.contains("romane"));
+        EXPECT_TRUE(tree.contains("romanus"));
+        EXPECT_EQ(tree.size(), 3);
+    }
+
+    TEST(HW09Radix, LongSharedPrefixes)
+    {
+        RadixTree<std::string> tree;
+        std::string base(40, 'x');
+        EXPECT_TRUE(tree.insert(base + "1"));
+        EXPECT_TRUE(tree.insert(base + "2"));
+        EXPECT_TRUE(tree.insert(base.substr(0, 20)));
+        EXPECT_TRUE(tree.insert(base.substr(0, 20) + "y"));
+        EXPECT_FALSE(tree.contains(base));
+        EXPECT_FALSE(tree.contains(base.substr(0, 30)));
+        EXPECT_TRUE(tree.contains(base + "2"));
+
+        EXPECT_TRUE(tree.remove(base.substr(0, 20) + "y"));
+        EXPECT_TRUE(tree.remove(base.substr(0, 20)));
+        EXPECT_TRUE(tree.contains(base + "1"));
+        EXPECT_TRUE(tree.contains(base + "2"));
+        EXPECT_TRUE(tree.remove(base + "1"));
+        EXPECT_TRUE(tree.contains(base + "2"));
+        EXPECT_EQ(tree.size(), 1);
+    }
+
+    TEST(HW09Radix, MatchesStdSet)
+    {
+        std::mt19937 rng(3);
+        std::set<std::string> reference;
+        RadixTree<std::string> tree;
+
+        for (int i = 0; i < 20000; ++i) {
+            std::string url = random_url(rng);
+            if (rng() % 3 == 0) {
+                ASSERT_EQ(tree.remove(url), reference.erase(url) == 1) << url;
+            } else {
+                ASSERT_EQ(tree.insert(url), reference.insert(url).second) << url;
+            }
+            ASSERT_EQ(tree.contains(url), reference.count(url) == 1) << url;
+        }
+        EXPECT_EQ(tree.size(), reference.size());
+
+        std::vector<std::string> ordered;
+        tree.for_each([&](const std::string& key) { ordered.push_back(key); });
+        EXPECT_EQ(ordered, std::vector<std::string>(reference.begin(), reference.end()));
+    }
+
+    TEST(HW09Radix, PrefixScan)
+    {
+        RadixTree<std::string> tree;
+        for (const char* key : {"app", "apple", "applet", "apply", "banana", "ap"}) {
+            tree.insert(key);
+        }
+
+        std::vector<std::string> hits;
+        tree.scan_prefix("appl", [&](const std::string& key) { hits.push_back(key); });
+        EXPECT_EQ(hits, (std::vector<std::string>{"apple", "applet", "apply"}));
+
+        hits.clear();
+        tree.scan_prefix("b", [&](const std::string& key) { hits.push_back(key); });
+        EXPECT_EQ(hits, (std::vector<std::string>{"banana"}));
+
+        hits.clear();
+        tree.scan_prefix("c", [&](const std::string& key) { hits.push_back(key); });
+        EXPECT_TRUE(hits.empty());
+
+        hits.clear();
+        tree.scan_prefix("", [&](const std::string& key) { hits.push_back(key); });
+        EXPECT_EQ(hits.size(), 6);
+    }
+
+    TEST(HW09Radix, IntegerKeysGrowAndShrink)
+    {
+        RadixTree<int> tree;
+        std::set<int> reference;
+        // Spreads keys over every first byte so inner nodes reach 256 children.
+        for (int i = -300; i < 300; ++i) {
+            int key = i * 7000000;
+            EXPECT_EQ(tree.insert(key), reference.insert(key).second);
+        }
+        std::vector<int> ordered;
+        tree.for_each([&](int key) { ordered.push_back(key); });
+        EXPECT_EQ(ordered, std::vector<int>(reference.begin(), reference.end()));
+
+        for (int i = -300; i < 300; i += 2) {
+            int key = i * 7000000;
+            EXPECT_EQ(tree.remove(key), reference.erase(key) == 1);
+        }
+        for (int i = -300; i < 300; ++i) {
+            int key = i * 7000000;
+            EXPECT_EQ(tree.contains(key), reference.count(key) == 1);
+        }
+        EXPECT_EQ(tree.size(), reference.size());
+
+        RadixTree<int> copy(tree);
+        EXPECT_TRUE(copy == tree);
+        copy.remove(*reference.begin());
+        EXPECT_TRUE(copy != tree);
+    }
+
+    TEST(HW09Radix, UrlKeysTakeLessMemoryThanTree)
+    {
+        std::vector<std::string> urls;
+        for (int product = 0; product < 2000; ++product) {
+            for (int page = 1; page <= 5; ++page) {
+                urls.push_back("https://www.example.com/products/" + std::to_string(product * 7919)
+                               + "/reviews?page=" + std::to_string(page));
+            }
+        }
+
+        // The BinarySearchTree core is the exercise, so build its nodes directly.
+        using Node = BinarySearchTree<std::string>::Node;
+        int64_t tree_bytes;
+        Node* root = nullptr;
+        {
+            alloc::AllocationScope scope;
+            for (const std::string& url : urls) {
+                bst::insert(root, new Node(url));
+            }
+            tree_bytes = scope.stats().live_bytes;
+        }
+        int64_t radix_bytes;
+        RadixTree<std::string> radix;
+        {
+            alloc::AllocationScope scope;
+            for (const std::string& url : urls) {
+                radix.insert(url);
+            }
+            radix_bytes = scope.stats().live_bytes;
+        }
+        bst::destroy(root);
+
+        double tree_per_key = double(tree_bytes) / urls.size();
+        double radix_per_key = double(radix_bytes) / urls.size();
+        RecordProperty("tree_bytes_per_key", std::to_string(tree_per_key));
+        RecordProperty("radix_bytes_per_key", std::to_string(radix_per_key));
+        EXPECT_EQ(radix.size(), urls.size());
+        EXPECT_LT(radix_per_key * 2, tree_per_key) << "radix " << radix_per_key << " B/key, tree "
+                                                   << tree_per_key << " B/key";
+    }
+}
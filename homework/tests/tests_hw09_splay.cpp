@@ -0,0 +1,150 @@
+#include "hw09_splay.h"
+#include "gtest/gtest.h"
+#include <memory_resource>
+#include <random>
+#include <set>
+#include <stdexcept>
+
+namespace cppclass
+{
+    // Throws from its move constructor once moves_left runs out.
+    struct Brittle {
+        static inline int moves_left = -1;
+
+        explicit Brittle(int value) : value(value) {}
+        Brittle(const Brittle&) = default;
+        Brittle(Brittle&& other) : value(other.value)
+        {
+            if (moves_left >= 0 && moves_left-- == 0) {
+                throw std::runtime_error("move failed");
+            }
+        }
+
+        bool operator<(const Brittle& other) const { return value < other.value; }
+        bool operator>(const Brittle& other) const { return value > other.value; }
+        bool operator==(const Brittle& other) const { return value == other.value; }
+
+        int value;
+    };
+
+    TEST(HW09Splay, InsertContainsRemove)
+    {
+        SplayTree<int> tree;
+        EXPECT_EQ(tree.size(), 0);
+        EXPECT_FALSE(tree.contains(1));
+        EXPECT_FALSE(tree.remove(1));
+
+        EXPECT_TRUE(tree.insert(5));
+        EXPECT_TRUE(tree.insert(3));
+        EXPECT_TRUE(tree.insert(8));
+        EXPECT_FALSE(tree.insert(3));
+        EXPECT_EQ(tree.size(), 3);
+
+        EXPECT_TRUE(tree.contains(3));
+        EXPECT_TRUE(tree.contains(8));
+        EXPECT_FALSE(tree.contains(4));
+
+        EXPECT_TRUE(tree.remove(5));
+        EXPECT_FALSE(tree.contains(5));
+        EXPECT_EQ(tree.size(), 2);
+    }
+
+    TEST(HW09Splay, MatchesStdSet)
+    {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> key(0, 500);
+        std::uniform_int_distribution<int> op(0, 2);
+        std::set<int> reference;
+        SplayTree<int> tree;
+
+        for (int i = 0; i < 20000; ++i) {
+            int k = key(rng);
+            switch (op(rng)) {
+            case 0:
+                EXPECT_EQ(tree.insert(k), reference.insert(k).second);
+                break;
+            case 1:
+                EXPECT_EQ(tree.remove(k), reference.erase(k) == 1);
+                break;
+            default:
+                EXPECT_EQ(tree.contains(k), reference.count(k) == 1);
+                break;
+            }
+            ASSERT_EQ(tree.size(), reference.size());
+        }
+    }
+
+    TEST(HW09Splay, CopyMoveEquality)
+    {
+        int values[] = {4, 2, 6, 1, 3, 5, 7};
+        SplayTree<int> a(values, 7);
+        SplayTree<int> b(a);
+        EXPECT_TRUE(a == b);
+
+        // Lookups reshape one tree but must not affect equality.
+        EXPECT_TRUE(b.contains(1));
+        EXPECT_TRUE(a.contains(7));
+        EXPECT_TRUE(a == b);
+
+        b.remove(4);
+        EXPECT_TRUE(a != b);
+
+        SplayTree<int> c(std::move(a));
+        EXPECT_EQ(a.size(), 0);
+        EXPECT_EQ(c.size(), 7);
+        EXPECT_TRUE(c.contains(4));
+    }
+
+    TEST(HW09Splay, AssignAndSwap)
+    {
+        int values[] = {4, 2, 6, 1, 3, 5, 7};
+        SplayTree<int> a(values, 7);
+        SplayTree<int> b(values, 3);
+
+        SplayTree<int> c;
+        c = a;
+        EXPECT_TRUE(c == a);
+        c = c;
+        EXPECT_TRUE(c == a);
+
+        swap(a, b);
+        EXPECT_EQ(a.size(), 3);
+        EXPECT_EQ(b.size(), 7);
+        EXPECT_TRUE(b == c);
+
+        a = std::move(b);
+        EXPECT_EQ(b.size(), 0);
+        EXPECT_FALSE(b.contains(4));
+        EXPECT_TRUE(a == c);
+
+        b = std::move(b);
+        EXPECT_EQ(b.size(), 0);
+        b.insert(9);
+        EXPECT_TRUE(b.contains(9));
+    }
+
+    TEST(HW09Splay, MoveAssignThrowingElementLeavesTargetEmpty)
+    {
+        std::pmr::unsynchronized_pool_resource source_resource;
+        std::pmr::unsynchronized_pool_resource target_resource;
+        pmr::SplayTree<Brittle> source(&source_resource);
+        pmr::SplayTree<Brittle> target(&target_resource);
+        for (int v : {4, 2, 6, 1, 3, 5, 7}) {
+            source.insert(Brittle(v));
+        }
+        target.insert(Brittle(9));
+
+        // Different resources, so the values are moved one by one into new nodes.
+        Brittle::moves_left = 3;
+        EXPECT_THROW(target = std::move(source), std::runtime_error);
+        Brittle::moves_left = -1;
+
+        EXPECT_EQ(target.size(), 0);
+        size_t visited = 0;
+        target.for_each([&](const Brittle&) { ++visited; });
+        EXPECT_EQ(visited, 0);
+        EXPECT_FALSE(target.contains(Brittle(4)));
+        EXPECT_TRUE(target.insert(Brittle(8)));
+        EXPECT_EQ(target.size(), 1);
+    }
+}
@@ -0,0 +1,70 @@
+#include "hw09.h"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <random>
+
+namespace cppclass
+{
+    using Node = BinarySearchTree<int>::Node;
+
+    TEST(HW09Verify, Treap)
+    {
+        std::mt19937 rng(9);
+        Node* root = nullptr;
+        size_t inserted = 0;
+        for (int i = 0; i < 50000; ++i) {
+            Node* node = new Node(static_cast<int>(rng() % 1000000));
+            if (bst::insert(root, node)) {
+                ++inserted;
+            } else {
+                delete node;
+            }
+        }
+
+        for (unsigned fork_depth : {0u, 4u}) {
+            bst::Verification facts = bst::verify(root, fork_depth);
+            EXPECT_TRUE(facts.ordered);
+            EXPECT_TRUE(facts.heap_ordered);
+            EXPECT_EQ(facts.count, inserted);
+            // A treap's expected height is about 3 log2 n; a degenerate shape would be far deeper.
+            EXPECT_LT(facts.height, 4 * std::log2(inserted + 1));
+        }
+        bst::destroy(root);
+    }
+
+    TEST(HW09Verify, DetectsOrderViolation)
+    {
+        // 10 sits in the right subtree of 20, which a valid BST cannot allow
+        // even though it is the left child of 30.
+        Node* root = new Node(20);
+        root->left = new Node(5);
+        root->right = new Node(30);
+        root->right->left = new Node(10);
+
+        for (unsigned fork_depth : {0u, 2u}) {
+            bst::Verification facts = bst::verify(root, fork_depth);
+            EXPECT_FALSE(facts.ordered);
+            EXPECT_EQ(facts.count, 4);
+            EXPECT_EQ(facts.height, 3);
+        }
+
+        root->right->left->data = 25;
+        EXPECT_TRUE(bst::verify(root).ordered);
+        bst::destroy(root);
+    }
+
+    TEST(HW09Verify, DegenerateChain)
+    {
+        Node* root = nullptr;
+        Node** slot = &root;
+        for (int i = 0; i < 200000; ++i) {
+            *slot = new Node(i);
+            slot = &(*slot)->right;
+        }
+        bst::Verification facts = bst::verify(root, 0);
+        EXPECT_TRUE(facts.ordered);
+        EXPECT_EQ(facts.count, 200000);
+        EXPECT_EQ(facts.height, 200000);
+        EXPECT_EQ(bst::destroy(root), 200000);
+    }
+}
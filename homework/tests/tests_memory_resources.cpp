@@ -0,0 +1,249 @@
+#include "hw08_basic.h"
+#include "hw09_dump.h"
+#include "hw09_splay.h"
+#include "memory_resources.h"
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <set>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace cppclass
+{
+namespace pmr
+{
+namespace
+{
+    // Upstream that counts what is taken from and returned to the heap.
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t allocations = 0;
+        size_t deallocations = 0;
+        size_t live_bytes = 0;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocations;
+            live_bytes += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            ++deallocations;
+            live_bytes -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    bool aligned(const void* p, size_t alignment)
+    {
+        return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+    }
+}
+
+    static_assert(std::is_nothrow_move_constructible_v<pmr::SplayTree<int>>);
+    static_assert(!std::is_nothrow_move_assignable_v<pmr::SplayTree<int>>);
+    static_assert(!std::is_nothrow_move_assignable_v<pmr::BasicLinkedList<int>>);
+
+    TEST(MemoryResources, ArenaBumpsAndReleasesAtOnce)
+    {
+        CountingResource upstream;
+        {
+            MonotonicArena arena(1024, &upstream);
+            EXPECT_EQ(upstream.allocations, 0);
+            void* a = arena.allocate(3, 1);
+            void* b = arena.allocate(8, 8);
+            void* c = arena.allocate(64, 64);
+            EXPECT_TRUE(aligned(b, 8));
+            EXPECT_TRUE(aligned(c, 64));
+            EXPECT_LT(static_cast<char*>(a), static_cast<char*>(b));
+            EXPECT_EQ(upstream.allocations, 1);
+
+            arena.deallocate(b, 8, 8);
+            EXPECT_EQ(upstream.deallocations, 0);
+            for (int i = 0; i < 1000; ++i) {
+                EXPECT_NE(arena.allocate(24, 8), nullptr);
+            }
+            void* big = arena.allocate(100000, 16);
+            EXPECT_TRUE(aligned(big, 16));
+            EXPECT_EQ(arena.bytes_allocated(), 3 + 8 + 64 + 24000 + 100000);
+            // Chunks double, so 100 KB in small pieces takes only a handful.
+            EXPECT_LE(upstream.allocations, 8);
+
+            arena.release();
+            EXPECT_EQ(upstream.live_bytes, 0);
+            EXPECT_EQ(arena.bytes_allocated(), 0);
+            EXPECT_NE(arena.allocate(16, 16), nullptr);
+            EXPECT_GT(upstream.live_bytes, 0);
+        }
+        EXPECT_EQ(upstream.live_bytes, 0);
+        EXPECT_EQ(upstream.allocations, upstream.deallocations);
+    }
+
+    TEST(MemoryResources, ArenaUsesBufferFirst)
+    {
+        CountingResource upstream;
+        alignas(16) char buffer[512];
+        MonotonicArena arena(buffer, sizeof(buffer), &upstream);
+        void* first = arena.allocate(100, 4);
+        EXPECT_EQ(first, static_cast<void*>(buffer));
+        EXPECT_NE(arena.allocate(300, 8), nullptr);
+        EXPECT_EQ(upstream.allocations, 0);
+        void* spill = arena.allocate(200, 8);
+        EXPECT_EQ(upstream.allocations, 1);
+        EXPECT_TRUE(spill < static_cast<void*>(buffer) || spill >= static_cast<void*>(buffer + sizeof(buffer)));
+        arena.release();
+        EXPECT_EQ(upstream.live_bytes, 0);
+        EXPECT_EQ(arena.allocate(8, 8), static_cast<void*>(buffer));
+    }
+
+    TEST(MemoryResources, ArenaRejectsHugeRequests)
+    {
+        CountingResource upstream;
+        MonotonicArena arena(1024, &upstream);
+        // Volatile so the compiler does not flag the sizes as impossible.
+        volatile size_t wraps = SIZE_MAX - 8;
+        EXPECT_THROW((void)arena.allocate(wraps, 8), std::bad_alloc);
+        EXPECT_EQ(upstream.allocations, 0);
+
+        void* p = arena.allocate(64, 16);
+        EXPECT_TRUE(aligned(p, 16));
+        EXPECT_EQ(arena.bytes_allocated(), 64);
+        EXPECT_EQ(upstream.allocations, 1);
+
+        // Large enough that doubling the chunk size would overflow; the upstream refuses it.
+        MonotonicArena big(1024);
+        volatile size_t half = SIZE_MAX / 2 + 1;
+        EXPECT_THROW((void)big.allocate(half, 16), std::bad_alloc);
+        EXPECT_NE(big.allocate(64, 16), nullptr);
+    }
+
+    TEST(MemoryResources, PoolRecyclesBySizeClass)
+    {
+        CountingResource upstream;
+        NodePool pool(4096, &upstream);
+        void* a = pool.allocate(24, 8);
+        void* b = pool.allocate(24, 8);
+        void* c = pool.allocate(40, 8);
+        EXPECT_TRUE(aligned(a, 16));
+        EXPECT_TRUE(aligned(c, 16));
+        EXPECT_EQ(static_cast<char*>(b) - static_cast<char*>(a), 32);
+        // Each size class carves its own slab.
+        EXPECT_EQ(pool.slab_count(), 2);
+
+        pool.deallocate(a, 24, 8);
+        EXPECT_EQ(pool.allocate(17, 8), a);
+        pool.deallocate(c, 40, 8);
+        EXPECT_EQ(pool.allocate(48, 16), c);
+
+        std::set<void*> seen;
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_TRUE(seen.insert(pool.allocate(32, 8)).second);
+        }
+        EXPECT_LE(pool.slab_count(), 2 + 1000 * 32 / (4096 - 16) + 1);
+
+        size_t before = upstream.allocations;
+        void* large = pool.allocate(1000, 8);
+        void* over_aligned = pool.allocate(32, 64);
+        EXPECT_EQ(upstream.allocations, before + 2);
+        EXPECT_TRUE(aligned(over_aligned, 64));
+        pool.deallocate(large, 1000, 8);
+        pool.deallocate(over_aligned, 32, 64);
+
+        pool.release();
+        EXPECT_EQ(pool.slab_count(), 0);
+        EXPECT_EQ(upstream.live_bytes, 0);
+    }
+
+    TEST(MemoryResources, ListOnPool)
+    {
+        CountingResource upstream;
+        NodePool pool(16384, &upstream);
+        {
+            pmr::BasicLinkedList<int> list(&pool);
+            for (int i = 0; i < 1000; ++i) {
+                list.append(i);
+            }
+            while (list.get_size() > 500) {
+                list.erase(list.at(0));
+            }
+            for (int i = 0; i < 500; ++i) {
+                list.insert(-i);
+            }
+            EXPECT_EQ(list.get_size(), 1000);
+            // Nodes are 24 bytes, so 1000 of them fit in two 16 KB slabs.
+            EXPECT_EQ(upstream.allocations, 2);
+            EXPECT_EQ(list.get_allocator().resource(), &pool);
+
+            // A plain copy uses the default resource, as std::pmr containers do...
+            pmr::BasicLinkedList<int> copy(list);
+            EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+            // ...unless it is given one.
+            pmr::BasicLinkedList<int> pooled(list, &pool);
+            EXPECT_EQ(pooled.get_allocator().resource(), &pool);
+            EXPECT_TRUE(pooled == list);
+
+            // Same resource: the nodes themselves change hands.
+            auto first = pooled.at(0);
+            pmr::BasicLinkedList<int> target(&pool);
+            target = std::move(pooled);
+            EXPECT_EQ(target.at(0), first);
+            EXPECT_EQ(pooled.get_size(), 0);
+
+            // Different resources: the list keeps its resource and the values move.
+            copy = std::move(target);
+            EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+            EXPECT_NE(copy.at(0), first);
+            EXPECT_TRUE(copy == list);
+            EXPECT_EQ(target.get_size(), 0);
+
+            copy = list;
+            EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+            EXPECT_TRUE(copy == list);
+        }
+        EXPECT_EQ(upstream.deallocations, 0);
+    }
+
+    TEST(MemoryResources, RequestScopedArena)
+    {
+        CountingResource upstream;
+        MonotonicArena arena(4096, &upstream);
+        std::ostringstream out;
+        {
+            pmr::SplayTree<int> tree(&arena);
+            pmr::BasicLinkedList<std::string> names(&arena);
+            for (int i = 0; i < 2000; ++i) {
+                tree.insert(i * 7 % 2000);
+                if (i % 100 == 0) {
+                    names.emplace_append(nullptr, "name");
+                }
+            }
+            EXPECT_TRUE(tree.contains(1234));
+            EXPECT_TRUE(tree.remove(1234));
+            EXPECT_EQ(tree.size(), 1999);
+
+            size_t used = arena.bytes_allocated();
+            {
+                bst::Sink sink(out, 1024, &arena);
+                sink.value(42);
+            }
+            EXPECT_GE(arena.bytes_allocated() - used, 1024u);
+        }
+        EXPECT_EQ(out.str(), "42");
+        EXPECT_LE(upstream.allocations, 10);
+        EXPECT_EQ(upstream.deallocations, 0);
+        arena.release();
+        EXPECT_EQ(upstream.live_bytes, 0);
+    }
+} // namespace pmr
+} // namespace cppclass
@@ -0,0 +1,150 @@
+#include "guarded.h"
+#include "hw09_bloom.h"
+#include "hw09_compact.h"
+#include "hw09_splay.h"
+#include "policies.h"
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cppclass
+{
+namespace
+{
+    // Stateful allocator that counts live allocations in a shared counter.
+    template <typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        explicit CountingAllocator(long* live) : live(live) {}
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>& other) : live(other.live) {}
+
+        T* allocate(size_t n)
+        {
+            *live += static_cast<long>(n);
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, size_t n)
+        {
+            *live -= static_cast<long>(n);
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template <typename U>
+        bool operator==(const CountingAllocator<U>& other) const
+        {
+            return live == other.live;
+        }
+
+        long* live;
+    };
+}
+
+    TEST(Policies, DefaultsCostNothing)
+    {
+        static_assert(sizeof(SplayTree<int>) == sizeof(void*) + sizeof(size_t));
+        static_assert(sizeof(Guarded<SplayTree<int>>) == sizeof(SplayTree<int>));
+        static_assert(sizeof(Guarded<CompactBinarySearchTree<int>>) == sizeof(CompactBinarySearchTree<int>));
+        static_assert(policy::mutating_reads<SplayTree<int>>::value);
+        static_assert(!policy::mutating_reads<CompactBinarySearchTree<int>>::value);
+        static_assert(policy::mutating_reads<BloomFiltered<SplayTree<int>>>::value);
+        static_assert(!policy::mutating_reads<BloomFiltered<CompactBinarySearchTree<int>>>::value);
+        // Copies hit the deleted copy constructor, not the forwarding one.
+        static_assert(!std::is_constructible_v<Guarded<SplayTree<int>>, Guarded<SplayTree<int>>&>);
+        static_assert(!std::is_constructible_v<Guarded<SplayTree<int>>, const Guarded<SplayTree<int>>&>);
+    }
+
+    TEST(Policies, SplayTreeUsesAllocator)
+    {
+        long live = 0;
+        {
+            CountingAllocator<int> alloc(&live);
+            SplayTree<int, CountingAllocator<int>> tree(alloc);
+            for (int i = 0; i < 50; ++i) {
+                tree.insert(i * 3 % 50);
+            }
+            EXPECT_EQ(live, 50);
+            EXPECT_TRUE(tree.remove(7));
+            EXPECT_EQ(live, 49);
+
+            SplayTree<int, CountingAllocator<int>> copy(tree);
+            EXPECT_EQ(live, 98);
+            EXPECT_TRUE(copy == tree);
+            EXPECT_EQ(copy.get_allocator().live, &live);
+
+            SplayTree<int, CountingAllocator<int>> moved(std::move(copy));
+            EXPECT_EQ(live, 98);
+            EXPECT_EQ(moved.size(), 49);
+        }
+        EXPECT_EQ(live, 0);
+    }
+
+    TEST(Policies, GuardedCountsOperations)
+    {
+        Guarded<SplayTree<int>, policy::NoLock, policy::CountingStats> set;
+        EXPECT_TRUE(set.insert(1));
+        EXPECT_TRUE(set.insert(2));
+        EXPECT_FALSE(set.insert(2));
+        EXPECT_TRUE(set.contains(1));
+        EXPECT_FALSE(set.contains(5));
+        EXPECT_TRUE(set.remove(1));
+        EXPECT_EQ(set.size(), 1);
+
+        EXPECT_EQ(set.stats().calls(policy::Operation::Insert), 3);
+        EXPECT_EQ(set.stats().hits(policy::Operation::Insert), 2);
+        EXPECT_EQ(set.stats().calls(policy::Operation::Find), 2);
+        EXPECT_EQ(set.stats().hits(policy::Operation::Find), 1);
+        EXPECT_EQ(set.stats().calls(policy::Operation::Erase), 1);
+        EXPECT_EQ(set.write([](SplayTree<int>& tree) { return tree.insert(9); }), true);
+        EXPECT_EQ(set.read([](const SplayTree<int>& tree) { return tree.size(); }), 2);
+    }
+
+    template <typename Set>
+    void hammer(Set& set, int threads, int per_thread)
+    {
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    int key = t * per_thread + i;
+                    set.insert(key);
+                    set.contains(key);
+                    set.contains(key - 1);
+                    if (i % 3 == 0) {
+                        set.remove(key);
+                    }
+                }
+            });
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+    TEST(Policies, GuardedIsThreadSafe)
+    {
+        const int threads = 4;
+        const int per_thread = 2000;
+        const size_t expected = threads * (per_thread - (per_thread + 2) / 3);
+
+        Guarded<SplayTree<int>, policy::SharedMutexLock, policy::CountingStats> splay;
+        hammer(splay, threads, per_thread);
+        EXPECT_EQ(splay.size(), expected);
+        EXPECT_EQ(splay.stats().calls(policy::Operation::Find), 2u * threads * per_thread);
+        EXPECT_EQ(splay.stats().hits(policy::Operation::Insert), 1u * threads * per_thread);
+
+        Guarded<CompactBinarySearchTree<int>, policy::SharedMutexLock> compact;
+        hammer(compact, threads, per_thread);
+        EXPECT_EQ(compact.size(), expected);
+
+        Guarded<CompactBinarySearchTree<int>, policy::MutexLock> locked;
+        hammer(locked, threads, per_thread);
+        EXPECT_EQ(locked.size(), expected);
+    }
+} // namespace cppclass
@@ -0,0 +1,226 @@
+#include "thread_pool.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cppclass
+{
+namespace runtime
+{
+namespace
+{
+    struct Counted : Task {
+        explicit Counted(std::atomic<int>* runs) : runs(runs) {}
+
+        void run() override
+        {
+            runs->fetch_add(1);
+        }
+
+        std::atomic<int>* runs;
+    };
+
+    long fibonacci(ThreadPool& pool, int n)
+    {
+        if (n < 2) {
+            return n;
+        }
+        if (n < 12) {
+            return fibonacci(pool, n - 1) + fibonacci(pool, n - 2);
+        }
+        long a = 0;
+        long b = 0;
+        pool.invoke([&] { a = fibonacci(pool, n - 1); }, [&] { b = fibonacci(pool, n - 2); });
+        return a + b;
+    }
+}
+
+    TEST(Runtime, DequeOwnerIsLifoThiefIsFifo)
+    {
+        std::atomic<int> runs{0};
+        std::deque<Counted> tasks;
+        for (int i = 0; i < 600; ++i) {
+            tasks.emplace_back(&runs);
+        }
+        WorkStealingDeque deque(4);
+        EXPECT_TRUE(deque.empty());
+        for (auto& task : tasks) {
+            deque.push(&task);
+        }
+        EXPECT_FALSE(deque.empty());
+        EXPECT_EQ(deque.pop(), &tasks[599]);
+        EXPECT_EQ(deque.steal(), &tasks[0]);
+        EXPECT_EQ(deque.steal(), &tasks[1]);
+        for (size_t i = 598; i >= 2; --i) {
+            ASSERT_EQ(deque.pop(), &tasks[i]);
+        }
+        EXPECT_EQ(deque.pop(), nullptr);
+        EXPECT_EQ(deque.steal(), nullptr);
+        EXPECT_TRUE(deque.empty());
+    }
+
+    TEST(Runtime, DequeHandsEachTaskOutOnce)
+    {
+        const int total = 200000;
+        std::atomic<int> runs{0};
+        std::deque<Counted> tasks;
+        for (int i = 0; i < total; ++i) {
+            tasks.emplace_back(&runs);
+        }
+        WorkStealingDeque deque(16);
+        std::atomic<bool> finished{false};
+        std::atomic<int> taken{0};
+
+        std::vector<std::thread> thieves;
+        for (int t = 0; t < 3; ++t) {
+            thieves.emplace_back([&] {
+                while (!finished.load() || !deque.empty()) {
+                    if (Task* task = deque.steal()) {
+                        task->execute();
+                        taken.fetch_add(1);
+                    }
+                }
+            });
+        }
+        for (int i = 0; i < total; ++i) {
+            deque.push(&tasks[i]);
+            if (i % 3 == 0) {
+                if (Task* task = deque.pop()) {
+                    task->execute();
+                    taken.fetch_add(1);
+                }
+            }
+        }
+        while (Task* task = deque.pop()) {
+            task->execute();
+            taken.fetch_add(1);
+        }
+        finished.store(true);
+        for (auto& thief : thieves) {
+            thief.join();
+        }
+        EXPECT_EQ(taken.load(), total);
+        EXPECT_EQ(runs.load(), total);
+        for (const auto& task : tasks) {
+            ASSERT_TRUE(task.done());
+        }
+    }
+
+    TEST(Runtime, ParallelForCoversRangeOnce)
+    {
+        ThreadPool pool(4);
+        EXPECT_EQ(pool.size(), 4);
+        EXPECT_FALSE(pool.on_worker());
+        for (size_t grain : {0, 1, 7, 1000, 100000}) {
+            std::vector<std::atomic<int>> hits(10007);
+            std::atomic<size_t> calls{0};
+            pool.parallel_for(3, hits.size(), [&](size_t lo, size_t hi) {
+                EXPECT_TRUE(pool.on_worker() || hi - lo == hits.size() - 3);
+                EXPECT_LE(hi - lo, grain == 0 ? hits.size() : grain);
+                for (size_t i = lo; i < hi; ++i) {
+                    hits[i].fetch_add(1);
+                }
+                calls.fetch_add(1);
+            }, grain);
+            for (size_t i = 0; i < hits.size(); ++i) {
+                ASSERT_EQ(hits[i].load(), i < 3 ? 0 : 1) << "grain " << grain << " index " << i;
+            }
+            if (grain == 1) {
+                EXPECT_EQ(calls.load(), hits.size() - 3);
+            }
+        }
+        pool.parallel_for(5, 5, [](size_t, size_t) { FAIL(); });
+    }
+
+    TEST(Runtime, ParallelReduceMatchesSerial)
+    {
+        ThreadPool pool(3);
+        std::vector<long> values(100000);
+        std::iota(values.begin(), values.end(), -500);
+        long expected = std::accumulate(values.begin(), values.end(), 0L);
+        auto sum = [&](size_t lo, size_t hi) { return std::accumulate(values.begin() + lo, values.begin() + hi, 0L); };
+        auto plus = [](long a, long b) { return a + b; };
+        EXPECT_EQ(pool.parallel_reduce(0, values.size(), 0L, sum, plus), expected);
+        EXPECT_EQ(pool.parallel_reduce(0, values.size(), 0L, sum, plus, 1), expected);
+        EXPECT_EQ(pool.parallel_reduce(0, 0, 42L, sum, plus), 42);
+
+        // Pieces are combined in order, so a non-commutative combine works.
+        auto digits = [](size_t lo, size_t hi) {
+            std::string text;
+            for (size_t i = lo; i < hi; ++i) {
+                text += static_cast<char>('a' + i % 26);
+            }
+            return text;
+        };
+        auto concat = [](std::string a, std::string b) { return a + b; };
+        EXPECT_EQ(pool.parallel_reduce(0, 52, std::string(), digits, concat, 3),
+                  "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz");
+    }
+
+    TEST(Runtime, NestedForksStayOnPoolThreads)
+    {
+        ThreadPool pool(4);
+        std::mutex mutex;
+        std::set<std::thread::id> seen;
+        pool.parallel_for(0, 64, [&](size_t, size_t) {
+            EXPECT_EQ(fibonacci(pool, 18), 2584);
+            std::lock_guard<std::mutex> lock(mutex);
+            seen.insert(std::this_thread::get_id());
+        }, 1);
+        EXPECT_LE(seen.size(), pool.size());
+        EXPECT_EQ(seen.count(std::this_thread::get_id()), 0);
+    }
+
+    TEST(Runtime, ManyCallersShareOnePool)
+    {
+        ThreadPool pool(2);
+        std::vector<std::thread> callers;
+        std::atomic<int> correct{0};
+        for (int t = 0; t < 6; ++t) {
+            callers.emplace_back([&] {
+                for (int round = 0; round < 20; ++round) {
+                    if (fibonacci(pool, 16) == 987) {
+                        correct.fetch_add(1);
+                    }
+                }
+            });
+        }
+        for (auto& caller : callers) {
+            caller.join();
+        }
+        EXPECT_EQ(correct.load(), 120);
+    }
+
+    TEST(Runtime, ExceptionsReachTheCaller)
+    {
+        ThreadPool pool(3);
+        EXPECT_THROW(pool.invoke([] { throw std::runtime_error("first"); }, [] {}), std::runtime_error);
+        EXPECT_THROW(pool.invoke([] {}, [] { throw std::logic_error("second"); }), std::logic_error);
+        EXPECT_THROW(pool.parallel_for(0, 1000, [](size_t lo, size_t) {
+            if (lo == 500) {
+                throw std::out_of_range("piece");
+            }
+        }, 1), std::out_of_range);
+        // The pool is still usable afterwards.
+        EXPECT_EQ(fibonacci(pool, 20), 6765);
+    }
+
+    TEST(Runtime, GlobalPool)
+    {
+        EXPECT_GE(ThreadPool::default_workers(), 1);
+        EXPECT_EQ(&ThreadPool::global(), &ThreadPool::global());
+        std::atomic<long> total{0};
+        parallel_for(0, 1000, [&](size_t lo, size_t hi) { total.fetch_add(static_cast<long>(hi - lo)); });
+        EXPECT_EQ(total.load(), 1000);
+        EXPECT_EQ(parallel_reduce(0, 1000, 0L, [](size_t lo, size_t hi) { return static_cast<long>(hi - lo); },
+                                  [](long a, long b) { return a + b; }), 1000);
+    }
+} // namespace runtime
+} // namespace cppclass